@@ -2,7 +2,32 @@
 // Created by aless on 21/11/2020.
 //
 
+#if defined(__unix__) || defined(__APPLE__)
+// unistd.h declares an access() that clashes with the one of this library, its declaration is renamed out of the way
+#define access access_unistd_arrayutils
+#include <unistd.h>
+#undef access
+#endif
 #include "ArrayUtils.h"
+#include <stdint.h>
+#include <math.h>
+#include <errno.h>
+#ifdef ARRAYUTILS_POSIX
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+#if defined(__linux__) && defined(__GNUC__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define ARRAYUTILS_IO_URING
+#endif
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #ifndef SIGUSR1
 #define SIGUSR1 SIGTERM
@@ -10,19 +35,40 @@
 #endif
 #define uint unsigned int
 #define ulong unsigned long
+#define usize size_t
 #define uchar unsigned char
 #define ll long long
 #define STD_CAPACITY 1
 #define REALLOC_FACTOR 2
+#define NONTEMPORAL_THRESHOLD ((size_t)-1)     // streaming is opt in, see tests/bench_copy.c
+#define PREFETCH_DISTANCE 512
+#define FILL_BLOCK 4096
+#define GALLOP_RATIO 32
+#define HEAP_ARITY 4
+#define TEXT_CHUNK (256 * 1024)
+#define PIPELINE_BLOCK (16 * 1024)
+#define IO_CHUNK (1024 * 1024)
+#define IO_DEPTH 4
+#define PACKED_BLOCK 128
+#define PACKED_MAGIC 0x4b505541u      // "AUPK"
+#define SCHUBFACH_K_MIN (-324)
+
+#ifdef __GNUC__
+#define PREFETCH(ptr) __builtin_prefetch(ptr, 0, 0)
+#else
+#define PREFETCH(ptr)
+#endif
 
-unsigned int std_capacity = STD_CAPACITY;
-unsigned int realloc_factor = REALLOC_FACTOR;
-int SIGNAL_USR_ArrayUtils = 0;
-ArrayUtilsTraceLevel TRACE_LVL = NoTrace;
+static size_t std_capacity = STD_CAPACITY;
+static unsigned int realloc_factor = REALLOC_FACTOR;
+static size_t nontemporal_threshold = NONTEMPORAL_THRESHOLD;
+static int SIGNAL_USR_ArrayUtils = 0;
+static ArrayUtilsTraceLevel TRACE_LVL = NoTrace;
 
 #define ASSERT_MIN_SIZE_CAPACITY(V, i, error_type, format, ...) {if (i >= V->size) { handle_err(error_type, format, ##__VA_ARGS__); }}
+#define ASSERT_VALID_RANGE(V, at, n, error_type, format, ...) {if (at > V->size || n > V->size - at) { handle_err(error_type, format, ##__VA_ARGS__); }}
 
-void handle_err(ArrayUtilsErrors error_type, const char *format, ...) {
+static void handle_err(ArrayUtilsErrors error_type, const char *format, ...) {
     va_list args;
     va_start(args, format);
     if (!SIGNAL_USR_ArrayUtils) {
@@ -39,42 +85,44 @@ void handle_err(ArrayUtilsErrors error_type, const char *format, ...) {
 
 struct Vector {
     unsigned char* data;
-    unsigned int objsize;
-    unsigned long size;
-    unsigned long capacity;
+    size_t objsize;
+    size_t size;
+    size_t capacity;
+    size_t slot;        // index in allocatedArrays.vectors
 };
 
 unsigned char* vdata(Vector* v) {
     return v->data;
 }
-unsigned int vsize(Vector* v) {
+size_t vsize(Vector* v) {
     return v->size;
 }
-unsigned long vcapacity(Vector *v) {
+size_t vcapacity(Vector *v) {
     return v->capacity;
 }
-unsigned int vobjsize(Vector* v) {
+size_t vobjsize(Vector* v) {
     return v->objsize;
 }
 
-struct AllocatedArrays allocatedArrays = {
+static struct AllocatedArrays allocatedArrays = {
     NULL,
     0,
-    1
+    1,
+    0
 };
 
 #ifdef __GNUC__             // __attribute__((constructor)) is only present in GCC, therefore we need to check this.
 #ifndef __clang__
-void init(void) __attribute__((constructor));
+static void init(void) __attribute__((constructor));
 
-void init(void) {
+static void init(void) {
     atexit(free_all_arrayutils_structures);
 }
 #endif
 #endif
 
 
-void* safe_alloc(ulong size) {
+static void* safe_alloc(usize size) {
     char* ptr = malloc(size);
     if (ptr == NULL) {
         handle_err(AllocationError, "Error in array allocation");
@@ -82,7 +130,7 @@ void* safe_alloc(ulong size) {
     return ptr;
 }
 
-void* safe_realloc(void* ptr, ulong size) {
+static void* safe_realloc(void* ptr, usize size) {
     ptr = realloc(ptr, size);
     if (ptr == NULL) {
         handle_err(ReallocationError, "Error in array reallocation");
@@ -90,9 +138,147 @@ void* safe_realloc(void* ptr, ulong size) {
     return ptr;
 }
 
-Vector* vector() {
+// returns 1 and stores a * b in res if the product fits in a size_t, 0 otherwise
+static int checked_mul(usize a, usize b, usize* res) {
+#ifdef __GNUC__
+    return !__builtin_mul_overflow(a, b, res);
+#else
+    if (b != 0 && a > (usize)-1 / b)
+        return 0;
+    *res = a * b;
+    return 1;
+#endif
+}
+
+// byte size of a buffer holding nobj objects of objsize, raises SizeOverflowError and sets ok to 0 if it doesn't fit
+static usize byte_size(usize objsize, usize nobj, int* ok) {
+    usize bytes;
+    *ok = checked_mul(objsize, nobj, &bytes);
+    if (!*ok) {
+        handle_err(SizeOverflowError, "Vector byte size overflows size_t");
+        return 0;
+    }
+    return bytes;
+}
+
+static int reallocate(Vector* vect, usize capacity) {
+    int ok;
+    usize bytes = byte_size(vect->objsize, capacity, &ok);
+    if (!ok)
+        return 0;
+    vect->data = safe_realloc(vect->data, bytes);
+    vect->capacity = capacity;
+    return 1;
+}
+
+// grows vect geometrically (by realloc_factor) until it can hold needed objects
+// if the geometric step would overflow it falls back to exactly needed, returns 0 if even that doesn't fit
+static int ensure_capacity(Vector* vect, usize needed) {
+    if (needed <= vect->capacity)
+        return 1;
+    usize cap = vect->capacity ? vect->capacity : 1;
+    usize bytes;
+    while (cap < needed) {
+        usize next;
+        if (!checked_mul(cap, realloc_factor, &next) || next <= cap)
+            next = needed;
+        cap = next;
+    }
+    if (!checked_mul(cap, vect->objsize, &bytes))
+        cap = needed;
+    return reallocate(vect, cap);
+}
+
+// checked vect->size + nobj, raises SizeOverflowError and returns 0 on overflow
+static int grow_by(Vector* vect, usize nobj) {
+    if (nobj > (usize)-1 - vect->size) {
+        handle_err(SizeOverflowError, "Vector size overflows size_t");
+        return 0;
+    }
+    return ensure_capacity(vect, vect->size + nobj);
+}
+
+// copies bytes from src to dst with streaming stores that bypass the cache, src and dst must not overlap
+static void stream_copy(uchar* dst, const uchar* src, usize bytes) {
+#if defined(__SSE2__)
+    usize head = (16 - ((uintptr_t)dst & 15)) & 15;
+    if (head > bytes)
+        head = bytes;
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    bytes -= head;
+    while (bytes >= 64) {
+        PREFETCH(src + PREFETCH_DISTANCE);
+        __m128i a = _mm_loadu_si128((const __m128i*)src);
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*)(src + 32));
+        __m128i d = _mm_loadu_si128((const __m128i*)(src + 48));
+        _mm_stream_si128((__m128i*)dst, a);
+        _mm_stream_si128((__m128i*)(dst + 16), b);
+        _mm_stream_si128((__m128i*)(dst + 32), c);
+        _mm_stream_si128((__m128i*)(dst + 48), d);
+        dst += 64;
+        src += 64;
+        bytes -= 64;
+    }
+    _mm_sfence();
+#endif
+    memcpy(dst, src, bytes);
+}
+
+// memcpy that switches to streaming stores for copies of at least nontemporal_threshold bytes
+static void bulk_copy(uchar* dst, const uchar* src, usize bytes) {
+    if (bytes < nontemporal_threshold)
+        memcpy(dst, src, bytes);
+    else
+        stream_copy(dst, src, bytes);
+}
+
+// memmove counterpart of bulk_copy, only ranges that don't overlap are streamed
+// (shifting a tail by a few bytes in streamed pieces is far slower than memmove)
+static void bulk_move(uchar* dst, const uchar* src, usize bytes) {
+    usize dist = dst > src ? (usize)(dst - src) : (usize)(src - dst);
+    if (bytes < nontemporal_threshold || dist < bytes)
+        memmove(dst, src, bytes);
+    else
+        stream_copy(dst, src, bytes);
+}
+
+// writes nobj copies of the objsize bytes at val to dst by doubling the already written pattern
+static void pattern_fill(uchar* dst, const uchar* val, usize objsize, usize nobj) {
+    usize total = objsize * nobj;
+    if (total == 0)
+        return;
+    usize same = 1;
+    while (same < objsize && val[same] == val[0])
+        same++;
+    if (same == objsize) {
+        memset(dst, val[0], total);
+        return;
+    }
+    memcpy(dst, val, objsize);
+    usize filled = objsize;
+    while (filled < total && filled < FILL_BLOCK) {
+        usize n = total - filled < filled ? total - filled : filled;
+        memcpy(dst + filled, dst, n);
+        filled += n;
+    }
+    // the first block is a whole number of objects and stays hot in cache, replicate it over the rest
+    usize block = filled;
+    while (filled < total) {
+        usize n = total - filled < block ? total - filled : block;
+        if (total < nontemporal_threshold)
+            memcpy(dst + filled, dst, n);
+        else
+            stream_copy(dst + filled, dst, n);
+        filled += n;
+    }
+}
+
+static Vector* vector() {
     Vector* v = safe_alloc(sizeof(Vector));
-    if (allocatedArrays.nvectors == 0) {
+    if (allocatedArrays.vectors == NULL) {
         allocatedArrays.vectors = safe_alloc(sizeof(Vector *) * allocatedArrays.capacity);
     }
     allocatedArrays.nvectors++;
@@ -101,105 +287,118 @@ Vector* vector() {
         allocatedArrays.vectors = safe_realloc(allocatedArrays.vectors, sizeof(Vector *) * allocatedArrays.capacity);
     }
     allocatedArrays.vectors[allocatedArrays.nvectors-1] = v;
+    v->slot = allocatedArrays.nvectors-1;
     return v;
 }
-Vector* vector_new(uint objsize) {
-    Vector* v = vector();
-    v->objsize = objsize;
-    v->capacity = std_capacity;
-    v->size = 0;
-    v->data = safe_alloc(objsize * std_capacity);
-    return v;
+Vector* vector_new(usize objsize) {
+    return vector_fromsize(objsize, std_capacity);
 }
-Vector* vector_fromsize(uint objsize, ulong capacity) {
+Vector* vector_fromsize(usize objsize, usize capacity) {
+    int ok;
+    usize bytes = byte_size(objsize, capacity, &ok);
+    if (!ok)
+        return NULL;
     Vector* v = vector();
     v->objsize = objsize;
     v->capacity = capacity;
     v->size = 0;
-    v->data = safe_alloc(objsize * capacity);
+    v->data = safe_alloc(bytes);
     return v;
 }
 
-Vector* vector_from_args_int(int n_of_elements, ...) {
+Vector* vector_from_args_int(usize n_of_elements, ...) {
     va_list args;
     va_start(args, n_of_elements);
     Vector* v = vector_fromsize(sizeof(int), n_of_elements);
-    for (int i = 0; i < n_of_elements; i++) {
+    for (usize i = 0; i < n_of_elements; i++) {
         int arg = va_arg(args, int);
         add(v, &arg);
     }
+    va_end(args);
     return v;
 }
 
-void add(Vector* vect, void* obj) {
-    if (vect->size == vect->capacity) {
-        vect->data = safe_realloc(vect->data, vect->capacity * realloc_factor * vect->objsize);
-        vect->capacity = vect->capacity * realloc_factor;
+void vector_reserve(Vector* vect, usize capacity) {
+    if (capacity > vect->capacity)
+        reallocate(vect, capacity);
+}
+
+void vector_resize(Vector* vect, usize size) {
+    if (size > vect->size) {
+        if (!ensure_capacity(vect, size))
+            return;
+        memset(vect->data + (vect->size * vect->objsize), 0, (size - vect->size) * vect->objsize);
     }
+    vect->size = size;
+}
+
+void vector_clear(Vector* vect) {
+    vect->size = 0;
+}
+
+void add(Vector* vect, void* obj) {
+    if (!grow_by(vect, 1))
+        return;
     memcpy((vect->data)+(vect->objsize * vect->size), obj, vect->objsize);
     vect->size++;
 }
 
-void add_range_move(Vector* vect, void* objs, uint nobj) {
-    while (vect->size + nobj >= vect->capacity) {
-        vect->data = safe_realloc(vect->data, vect->capacity * realloc_factor * vect->objsize);
-        vect->capacity = vect->capacity * realloc_factor;
-    }
-    memmove(vect->data + (vect->size * vect->objsize), objs, vect->objsize * nobj);
+void add_range_move(Vector* vect, void* objs, usize nobj) {
+    if (!grow_by(vect, nobj))
+        return;
+    bulk_move(vect->data + (vect->size * vect->objsize), objs, vect->objsize * nobj);
     vect->size += nobj;
 }
 
-void add_range_copy(Vector* vect, void* objs, uint nobj) {
-    while (vect->size + nobj >= vect->capacity) {
-        vect->data = safe_realloc(vect->data, vect->capacity * realloc_factor * vect->objsize);
-        vect->capacity = vect->capacity * realloc_factor;
-    }
-    memcpy(vect->data + (vect->size * vect->objsize), objs, vect->objsize * nobj);
+void add_range_copy(Vector* vect, void* objs, usize nobj) {
+    if (!grow_by(vect, nobj))
+        return;
+    bulk_copy(vect->data + (vect->size * vect->objsize), objs, vect->objsize * nobj);
     vect->size += nobj;
 }
 
-void add_range_move_at(Vector* vect, void* objs, uint nobj, uint at) {
+void add_range_move_at(Vector* vect, void* objs, usize nobj, usize at) {
     ASSERT_MIN_SIZE_CAPACITY(vect, at, OutOfBoundsAccessError, "Out of bounds attempt to insert")
-    while (vect->size + nobj >= vect->capacity) {
-        vect->data = safe_realloc(vect->data, vect->capacity * realloc_factor * vect->objsize);
-        vect->capacity = vect->capacity * realloc_factor;
-    }
-    memmove(vect->data + (vect->objsize * (at + nobj)), vect->data + (vect->objsize * at), vect->objsize * (vect->size - at));
-    memmove(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
+    if (!grow_by(vect, nobj))
+        return;
+    bulk_move(vect->data + (vect->objsize * (at + nobj)), vect->data + (vect->objsize * at), vect->objsize * (vect->size - at));
+    bulk_move(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
     vect->size += nobj;
 }
 
-void add_range_copy_at(Vector* vect, void* objs, uint nobj, uint at) {
+void add_range_copy_at(Vector* vect, void* objs, usize nobj, usize at) {
     ASSERT_MIN_SIZE_CAPACITY(vect, at, OutOfBoundsAccessError, "Out of bounds attempt to insert")
-    while (vect->size + nobj >= vect->capacity) {
-        vect->data = safe_realloc(vect->data, vect->capacity * realloc_factor * vect->objsize);
-        vect->capacity = vect->capacity * realloc_factor;
-    }
-    memmove(vect->data + (vect->objsize * (at + nobj)), vect->data + (vect->objsize * at), vect->objsize * (vect->size - at));
-    memcpy(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
+    if (!grow_by(vect, nobj))
+        return;
+    bulk_move(vect->data + (vect->objsize * (at + nobj)), vect->data + (vect->objsize * at), vect->objsize * (vect->size - at));
+    bulk_copy(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
     vect->size += nobj;
 }
 
-void replace_range_move(Vector* vect, void* objs, uint nobj, uint at) {
-    if (nobj > vect->size) {
+void replace_range_move(Vector* vect, void* objs, usize nobj, usize at) {
+    if (at > vect->size || nobj > vect->size - at) {
         handle_err(ReplaceMoreThanCurrentSizeError, "Trying to replace more items than what's currently in vector");
     }
-    memmove(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
+    bulk_move(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
 }
 
-void replace_range_copy(Vector* vect, void* objs, uint nobj, uint at) {
-    if (nobj > vect->size) {
+void replace_range_copy(Vector* vect, void* objs, usize nobj, usize at) {
+    if (at > vect->size || nobj > vect->size - at) {
         handle_err(ReplaceMoreThanCurrentSizeError, "Trying to replace more items than what's currently in vector");
     }
-    memcpy(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
+    bulk_copy(vect->data + (vect->objsize * at), objs, vect->objsize * nobj);
 }
 
-void* access(Vector* v, uint i) {
+void* access(Vector* v, usize i) {
     ASSERT_MIN_SIZE_CAPACITY(v, i, OutOfBoundsAccessError, "Out of bound access")
     return v->data + (v->objsize * i);
 }
 
-void* copy_access(Vector* v, uint i) {
+void* vector_at(Vector* v, usize i) {
+    return access(v, i);
+}
+
+void* copy_access(Vector* v, usize i) {
     ASSERT_MIN_SIZE_CAPACITY(v, i, OutOfBoundsAccessError, "Out of bound access")
     void* elem = safe_alloc(v->objsize);
     memcpy(elem, v->data + (v->objsize * i), v->objsize);
@@ -219,13 +418,13 @@ void pop_noret(Vector* vect) {
     vect->size--;
 }
 
-void delete_noret(Vector* vect, uint index) {
+void delete_noret(Vector* vect, usize index) {
     ASSERT_MIN_SIZE_CAPACITY(vect, index, OutOfBoundsAccessError, "Out of bounds delete attempt")
     memmove(vect->data + (vect->objsize * index), vect->data + (vect->objsize * (index + 1)), vect->objsize * (vect->size - index - 1));
     vect->size--;
 }
 
-void* delete(Vector* vect, uint index) {
+void* delete(Vector* vect, usize index) {
     ASSERT_MIN_SIZE_CAPACITY(vect, index, OutOfBoundsAccessError, "Out of bounds delete attempt")
     void* cpy = malloc(vect->objsize);
     memcpy(cpy, vect->data + (vect->objsize * index), vect->objsize);
@@ -235,43 +434,38 @@ void* delete(Vector* vect, uint index) {
 }
 
 void delete_value(Vector* vect, void* obj) {
-    int n;
+    usize n;
     any_match(vect, obj, &n);
-    if (n == -1)
+    if (n == ARRAYUTILS_NPOS)
         return;
     delete_noret(vect, n);
 }
 
-int delete_n_values(Vector* vect, void* obj, int n) {
-    int occ = count_matches(vect, obj);
+usize delete_n_values(Vector* vect, void* obj, usize n) {
+    usize occ = count_matches(vect, obj);
     if (n > occ)
         n = occ;
-    for (int i = 0; i < n; i++)
+    for (usize i = 0; i < n; i++)
         delete_value(vect, obj);
     return n;
 }
 
-int delete_values(Vector* vect, void* obj) {
-    int n = count_matches(vect, obj);
+usize delete_values(Vector* vect, void* obj) {
+    usize n = count_matches(vect, obj);
     return delete_n_values(vect, obj, n);
 }
 
-void fill(Vector* vect, void* val, uint nobj) {
-    while (vect->capacity < nobj) {
-        vect->data = safe_realloc(vect->data, vect->capacity * realloc_factor * vect->objsize);
-        vect->capacity = vect->capacity * realloc_factor;
-    }
-    for (uint i = 0; i < nobj; i++) {
-        memcpy(vect->data + (vect->objsize * i), val, vect->objsize);
-    }
+void fill(Vector* vect, void* val, usize nobj) {
+    if (!ensure_capacity(vect, nobj))
+        return;
+    pattern_fill(vect->data, val, vect->objsize, nobj);
     vect->size = nobj;
 }
 
-int n_matches_from_index(Vector* vect, void* val, int at, unsigned long size) {
-    ASSERT_MIN_SIZE_CAPACITY(vect, at, OutOfBoundsAccessError, "Out of bounds access attempted")
-    ASSERT_MIN_SIZE_CAPACITY(vect, at + size - 1, OutOfBoundsAccessError, "Out of bounds access attempted")
+int n_matches_from_index(Vector* vect, void* val, usize at, usize size) {
+    ASSERT_VALID_RANGE(vect, at, size, OutOfBoundsAccessError, "Out of bounds access attempted")
     int res;
-    for (int i = at; i < size; i++) {
+    for (usize i = at; i < at + size; i++) {
         res = memcmp(vect->data + (i * vect->objsize), val, vect->objsize);
         if (res)
             return 0;
@@ -279,73 +473,2225 @@ int n_matches_from_index(Vector* vect, void* val, int at, unsigned long size) {
     return 1;
 }
 
-int any_match_from_index(Vector* vect, void* val, int at, unsigned long size, int* n) {
-    ASSERT_MIN_SIZE_CAPACITY(vect, at, OutOfBoundsAccessError, "Out of bounds access attempted")
-    ASSERT_MIN_SIZE_CAPACITY(vect, at + size - 1, OutOfBoundsAccessError, "Out of bounds access attempted")
+int any_match_from_index(Vector* vect, void* val, usize at, usize size, usize* n) {
+    ASSERT_VALID_RANGE(vect, at, size, OutOfBoundsAccessError, "Out of bounds access attempted")
     int res;
-    for (int i = at; i < size; i++) {
+    for (usize i = at; i < at + size; i++) {
         res = memcmp(vect->data + (i * vect->objsize), val, vect->objsize);
         if (res == 0) {
             *n = i;
             return 1;
         }
     }
-    *n = -1;
+    *n = ARRAYUTILS_NPOS;
     return 0;
 }
 int all_match(Vector* vect, void* val) {
     return n_matches_from_index(vect, val, 0, vect->size);
 }
-int any_match(Vector* vect, void* val, int* n) {
+int any_match(Vector* vect, void* val, usize* n) {
     return any_match_from_index(vect, val, 0, vect->size, n);
 }
 
-int count_match_from_index(Vector* vect, void* val, int at, unsigned long size) {
-    ASSERT_MIN_SIZE_CAPACITY(vect, at, OutOfBoundsAccessError, "Out of bounds access attempted")
-    ASSERT_MIN_SIZE_CAPACITY(vect, at + size - 1, OutOfBoundsAccessError, "Out of bounds access attempted")
-    int count = 0;
-    for (int i = at; i < size; i++) {
+usize count_match_from_index(Vector* vect, void* val, usize at, usize size) {
+    ASSERT_VALID_RANGE(vect, at, size, OutOfBoundsAccessError, "Out of bounds access attempted")
+    usize count = 0;
+    for (usize i = at; i < at + size; i++) {
         if (memcmp(vect->data + (i * vect->objsize), val, vect->objsize) == 0)
             count++;
     }
     return count;
 }
 
-int count_matches(Vector* vect, void* val) {
+usize count_matches(Vector* vect, void* val) {
     return count_match_from_index(vect, val, 0, vect->size);
 }
 void reverse(Vector* vect) {
-    void* objs = safe_alloc(vect->objsize * vect->capacity);
-    for (int i = (int)vect->size - 1, j = 0; i >= 0; i--, j++)
-        memcpy(objs + (j * vect->objsize), vect->data + (i * vect->objsize), vect->objsize);
+    uchar* objs = safe_alloc(vect->objsize * vect->capacity);
+    for (usize i = vect->size, j = 0; i > 0; i--, j++)
+        memcpy(objs + (j * vect->objsize), vect->data + ((i - 1) * vect->objsize), vect->objsize);
     free(vect->data);
     vect->data = objs;
 }
 void* extract_match(Vector* vect, void* val) {
-    int i = 0;
+    usize i = 0;
     if (any_match(vect, val, &i))
         return vect->data + (i * vect->objsize);
     return NULL;
 }
 
+#define CMP_SCALAR(type) {type x = *(const type*)a, y = *(const type*)b; return (x > y) - (x < y);}
+int cmp_int32_arrayutils(const void* a, const void* b) CMP_SCALAR(int32_t)
+int cmp_uint32_arrayutils(const void* a, const void* b) CMP_SCALAR(uint32_t)
+int cmp_int64_arrayutils(const void* a, const void* b) CMP_SCALAR(int64_t)
+int cmp_uint64_arrayutils(const void* a, const void* b) CMP_SCALAR(uint64_t)
+#undef CMP_SCALAR
+
+typedef enum SetOperation {
+    SetMerge,
+    SetUnion,
+    SetIntersection,
+    SetDifference,
+} SetOperation;
+
+// first index in [lo, n) whose object is not less than key (greater than key if upper), exponential search followed by a binary one
+static usize gallop(const uchar* base, usize lo, usize n, usize objsize, const void* key, ArrayUtilsComparator cmp, int upper) {
+    usize hi = lo, step = 1;
+    while (hi < n) {
+        int c = cmp(base + (hi * objsize), key);
+        if (upper ? c > 0 : c >= 0)
+            break;
+        lo = hi + 1;
+        hi += step;
+        step <<= 1;
+    }
+    if (hi > n)
+        hi = n;
+    while (lo < hi) {
+        usize mid = lo + (hi - lo) / 2;
+        int c = cmp(base + (mid * objsize), key);
+        if (upper ? c <= 0 : c < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+#if defined(__SSE2__)
+// bit k of the result is set if the k-th of the 4 ints at a is equal to any of the 4 ints at b
+static int block_match_32(const uchar* a, const uchar* b) {
+    __m128i va = _mm_loadu_si128((const __m128i*)a);
+    __m128i vb = _mm_loadu_si128((const __m128i*)b);
+    __m128i m = _mm_cmpeq_epi32(va, vb);
+    m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+    m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+    return _mm_movemask_ps(_mm_castsi128_ps(m));
+}
+
+// same as block_match_32 for 2 64 bit ints, SSE2 has no 64 bit compare so the two 32 bit halves are and-ed together
+static int block_match_64(const uchar* a, const uchar* b) {
+    __m128i va = _mm_loadu_si128((const __m128i*)a);
+    __m128i vb = _mm_loadu_si128((const __m128i*)b);
+    __m128i e1 = _mm_cmpeq_epi32(va, vb);
+    __m128i e2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+    e1 = _mm_and_si128(e1, _mm_shuffle_epi32(e1, _MM_SHUFFLE(2, 3, 0, 1)));
+    e2 = _mm_and_si128(e2, _mm_shuffle_epi32(e2, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_movemask_pd(_mm_castsi128_pd(_mm_or_si128(e1, e2)));
+}
+
+static int simd_comparator(ArrayUtilsComparator cmp, usize objsize) {
+    if (objsize == 4)
+        return cmp == cmp_int32_arrayutils || cmp == cmp_uint32_arrayutils;
+    if (objsize == 8)
+        return cmp == cmp_int64_arrayutils || cmp == cmp_uint64_arrayutils;
+    return 0;
+}
+#endif
+
+static void set_operation(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp, SetOperation op) {
+    if (a->objsize != b->objsize || a->objsize != dest->objsize) {
+        handle_err(ObjectSizeMismatchError, "Set operation between vectors of different objsize");
+        return;
+    }
+    usize os = a->objsize, na = a->size, nb = b->size, i = 0, j = 0;
+    dest->size = 0;
+    if ((op == SetMerge || op == SetUnion) && nb > (usize)-1 - na) {
+        handle_err(SizeOverflowError, "Vector size overflows size_t");
+        return;
+    }
+    usize cap = op == SetIntersection ? (na < nb ? na : nb) : op == SetDifference ? na : na + nb;
+    if (!ensure_capacity(dest, cap))
+        return;
+    const uchar* A = a->data;
+    const uchar* B = b->data;
+    uchar* out = dest->data;
+    int keep_a = op != SetIntersection;             // objects only in a
+    int keep_b = op == SetMerge || op == SetUnion;  // objects only in b
+    int keep_eq = op != SetDifference;              // objects in both
+#define EMIT(src, n) {bulk_copy(out, src, (n) * os); out += (n) * os;}
+#if defined(__SSE2__)
+    if ((op == SetIntersection || op == SetDifference) && simd_comparator(cmp, os)
+        && na < nb * GALLOP_RATIO && nb < na * GALLOP_RATIO) {
+        usize w = 16 / os;
+        int (*match)(const uchar*, const uchar*) = os == 4 ? block_match_32 : block_match_64;
+        int want = op == SetIntersection;
+        int acc = 0;
+        while (i + w <= na && j + w <= nb) {
+            acc |= match(A + (i * os), B + (j * os));
+            int c = cmp(A + ((i + w - 1) * os), B + ((j + w - 1) * os));
+            if (c <= 0) {
+                for (usize k = 0; k < w; k++)
+                    if (((acc >> k) & 1) == want)
+                        EMIT(A + ((i + k) * os), 1)
+                i += w;
+                acc = 0;
+            }
+            if (c >= 0)
+                j += w;
+        }
+        // the current block of a may already have been matched against earlier blocks of b, settle what's below b[j]
+        for (usize k = 0; i < na && k < w && (j >= nb || cmp(A + (i * os), B + (j * os)) < 0); i++, k++)
+            if (((acc >> k) & 1) == want)
+                EMIT(A + (i * os), 1)
+    }
+#endif
+    if (na * GALLOP_RATIO < nb) {
+        for (; i < na && j < nb; i++) {
+            usize k = gallop(B, j, nb, os, A + (i * os), cmp, 0);
+            if (keep_b)
+                EMIT(B + (j * os), k - j)
+            j = k;
+            if (j < nb && cmp(A + (i * os), B + (j * os)) == 0) {
+                if (keep_eq)
+                    EMIT(A + (i * os), 1)
+                if (op != SetMerge)
+                    j++;
+            } else if (keep_a) {
+                EMIT(A + (i * os), 1)
+            }
+        }
+    } else if (nb * GALLOP_RATIO < na) {
+        for (; i < na && j < nb; j++) {
+            usize k = gallop(A, i, na, os, B + (j * os), cmp, op == SetMerge);
+            if (keep_a)
+                EMIT(A + (i * os), k - i)
+            i = k;
+            if (op != SetMerge && i < na && cmp(A + (i * os), B + (j * os)) == 0) {
+                if (keep_eq)
+                    EMIT(A + (i * os), 1)
+                i++;
+            } else if (keep_b) {
+                EMIT(B + (j * os), 1)
+            }
+        }
+    } else {
+        while (i < na && j < nb) {
+            int c = cmp(A + (i * os), B + (j * os));
+            if (c < 0) {
+                if (keep_a)
+                    EMIT(A + (i * os), 1)
+                i++;
+            } else if (c > 0) {
+                if (keep_b)
+                    EMIT(B + (j * os), 1)
+                j++;
+            } else {
+                if (keep_eq)
+                    EMIT(A + (i * os), 1)
+                i++;
+                if (op != SetMerge)
+                    j++;
+            }
+        }
+    }
+    if (keep_a)
+        EMIT(A + (i * os), na - i)
+    if (keep_b)
+        EMIT(B + (j * os), nb - j)
+#undef EMIT
+    dest->size = (usize)(out - dest->data) / os;
+}
+
+void vector_merge(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp) {
+    set_operation(dest, a, b, cmp, SetMerge);
+}
+
+void vector_set_union(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp) {
+    set_operation(dest, a, b, cmp, SetUnion);
+}
+
+void vector_set_intersection(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp) {
+    set_operation(dest, a, b, cmp, SetIntersection);
+}
+
+void vector_set_difference(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp) {
+    set_operation(dest, a, b, cmp, SetDifference);
+}
+
+usize vector_unique(Vector* vect, ArrayUtilsComparator cmp) {
+    if (vect->size == 0)
+        return 0;
+    usize os = vect->objsize, w = 0;
+    for (usize r = 1; r < vect->size; r++) {
+        if (cmp(vect->data + (w * os), vect->data + (r * os)) != 0) {
+            w++;
+            if (w != r)
+                memcpy(vect->data + (w * os), vect->data + (r * os), os);
+        }
+    }
+    usize removed = vect->size - (w + 1);
+    vect->size = w + 1;
+    return removed;
+}
+
+// memcpy of a single object, with the common sizes spelled out so they compile to plain loads and stores
+static void move_obj(uchar* dst, const uchar* src, usize objsize) {
+    switch (objsize) {
+        case 4:
+            memcpy(dst, src, 4);
+            break;
+        case 8:
+            memcpy(dst, src, 8);
+            break;
+        case 16:
+            memcpy(dst, src, 16);
+            break;
+        default:
+            memcpy(dst, src, objsize);
+    }
+}
+
+// moves the hole at index hole down until held fits in it, held must not be inside the first n objects
+static void sift_down(Heap* heap, usize hole, usize n, const uchar* held) {
+    uchar* data = heap->vect->data;
+    usize os = heap->vect->objsize, d = heap->arity;
+    for (;;) {
+        usize first = hole * d + 1;
+        if (first >= n)
+            break;
+        usize last = first + d < n ? first + d : n;
+        usize best = first;
+        for (usize c = first + 1; c < last; c++)
+            if (heap->cmp(data + (c * os), data + (best * os)) < 0)
+                best = c;
+        if (heap->cmp(data + (best * os), held) >= 0)
+            break;
+        move_obj(data + (hole * os), data + (best * os), os);
+        hole = best;
+    }
+    move_obj(data + (hole * os), held, os);
+}
+
+// moves the hole at index hole up until held fits in it, held must not be inside the heap
+static void sift_up(Heap* heap, usize hole, const uchar* held) {
+    uchar* data = heap->vect->data;
+    usize os = heap->vect->objsize, d = heap->arity;
+    while (hole > 0) {
+        usize parent = (hole - 1) / d;
+        if (heap->cmp(held, data + (parent * os)) >= 0)
+            break;
+        move_obj(data + (hole * os), data + (parent * os), os);
+        hole = parent;
+    }
+    move_obj(data + (hole * os), held, os);
+}
+
+// Floyd's bottom up construction, the object being sifted is held in a scratch buffer so the capacity of the vector is left alone
+static void rebuild_heap(Heap* heap) {
+    Vector* v = heap->vect;
+    if (v->size < 2)
+        return;
+    uchar small[64];
+    uchar* scratch = v->objsize <= sizeof(small) ? small : safe_alloc(v->objsize);
+    for (usize i = (v->size - 2) / heap->arity + 1; i > 0; i--) {
+        move_obj(scratch, v->data + ((i - 1) * v->objsize), v->objsize);
+        sift_down(heap, i - 1, v->size, scratch);
+    }
+    if (scratch != small)
+        free(scratch);
+}
+
+Heap heap_new(usize objsize, ArrayUtilsComparator cmp, uint arity) {
+    Heap heap = {vector_new(objsize), cmp, arity ? arity : HEAP_ARITY};
+    return heap;
+}
+
+Heap heapify(Vector* vect, ArrayUtilsComparator cmp, uint arity) {
+    Heap heap = {vect, cmp, arity ? arity : HEAP_ARITY};
+    rebuild_heap(&heap);
+    return heap;
+}
+
+void heap_push(Heap* heap, void* obj) {
+    Vector* v = heap->vect;
+    if (!grow_by(v, 1))
+        return;
+    sift_up(heap, v->size, obj);
+    v->size++;
+}
+
+void heap_push_batch(Heap* heap, void* objs, usize nobj) {
+    Vector* v = heap->vect;
+    if (nobj < v->size / 2) {
+        if (!grow_by(v, nobj))
+            return;
+        for (usize i = 0; i < nobj; i++)
+            heap_push(heap, (uchar*)objs + (i * v->objsize));
+        return;
+    }
+    add_range_copy(v, objs, nobj);
+    rebuild_heap(heap);
+}
+
+void heap_pop_into(Heap* heap, void* out) {
+    Vector* v = heap->vect;
+    if (v->size == 0) {
+        handle_err(EmptyPopError, "Trying to pop from empty heap");
+        return;
+    }
+    if (out != NULL)
+        memcpy(out, v->data, v->objsize);
+    v->size--;
+    if (v->size > 0)
+        sift_down(heap, 0, v->size, v->data + (v->size * v->objsize));
+}
+
+void* heap_top(Heap* heap) {
+    return heap->vect->size ? heap->vect->data : NULL;
+}
+
+usize heap_size(Heap* heap) {
+    return heap->vect->size;
+}
+
+void heap_free(Heap* heap) {
+    vector_free(heap->vect);
+}
+
+// stable bottom up merge sort of the n indices in idx by the key they point to, tmp must hold n indices too
+static void sort_indices(usize* idx, usize* tmp, usize n, const uchar* keys, usize ks, ArrayUtilsComparator cmp) {
+    usize sorted = 1;
+    while (sorted < n && cmp(keys + (idx[sorted - 1] * ks), keys + (idx[sorted] * ks)) <= 0)
+        sorted++;
+    if (sorted == n)
+        return;
+    usize* src = idx;
+    usize* dst = tmp;
+    for (usize width = 1; width < n; width *= 2) {
+        for (usize lo = 0; lo < n; lo += 2 * width) {
+            usize mid = lo + width < n ? lo + width : n;
+            usize hi = mid + width < n ? mid + width : n;
+            usize i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                dst[k++] = cmp(keys + (src[j] * ks), keys + (src[i] * ks)) < 0 ? src[j++] : src[i++];
+            while (i < mid)
+                dst[k++] = src[i++];
+            while (j < hi)
+                dst[k++] = src[j++];
+        }
+        usize* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != idx)
+        memcpy(idx, src, n * sizeof(usize));
+}
+
+FlatMap flatmap_new(usize keysize, usize valuesize, ArrayUtilsComparator cmp) {
+    FlatMap map = {vector_new(keysize), vector_new(valuesize), vector_new(keysize), vector_new(sizeof(usize)), cmp};
+    return map;
+}
+
+void flatmap_insert(FlatMap* map, void* key, void* value) {
+    flatmap_insert_batch(map, key, value, 1);
+}
+
+void flatmap_insert_batch(FlatMap* map, void* keys, void* values, usize nobj) {
+    if (nobj == 0)
+        return;
+    Vector* mk = map->keys;
+    Vector* mv = map->values;
+    usize ks = mk->objsize, vs = mv->objsize, n = mk->size;
+    if (nobj > (usize)-1 - n) {
+        handle_err(SizeOverflowError, "Vector size overflows size_t");
+        return;
+    }
+    int ok_idx, ok_k, ok_v;
+    usize idx_bytes = byte_size(sizeof(usize), nobj, &ok_idx);
+    usize k_bytes = byte_size(ks, n + nobj, &ok_k);
+    usize v_bytes = byte_size(vs, n + nobj, &ok_v);
+    if (!ok_idx || !ok_k || !ok_v)
+        return;
+    const uchar* bk = keys;
+    const uchar* bv = values;
+    usize* idx = safe_alloc(idx_bytes);
+    usize* tmp = safe_alloc(idx_bytes);
+    for (usize i = 0; i < nobj; i++)
+        idx[i] = i;
+    sort_indices(idx, tmp, nobj, bk, ks, map->cmp);
+    free(tmp);
+    uchar* nk = safe_alloc(k_bytes);
+    uchar* nv = safe_alloc(v_bytes);
+    usize i = 0, j = 0, out = 0;
+    while (i < n || j < nobj) {
+        if (j < nobj) {
+            // only the last of a run of equal keys in the batch is kept
+            while (j + 1 < nobj && map->cmp(bk + (idx[j] * ks), bk + (idx[j + 1] * ks)) == 0)
+                j++;
+        }
+        int c = i == n ? 1 : j == nobj ? -1 : map->cmp(mk->data + (i * ks), bk + (idx[j] * ks));
+        if (c < 0) {
+            memcpy(nk + (out * ks), mk->data + (i * ks), ks);
+            memcpy(nv + (out * vs), mv->data + (i * vs), vs);
+            i++;
+        } else {
+            memcpy(nk + (out * ks), bk + (idx[j] * ks), ks);
+            memcpy(nv + (out * vs), bv + (idx[j] * vs), vs);
+            j++;
+            if (c == 0)
+                i++;
+        }
+        out++;
+    }
+    free(idx);
+    free(mk->data);
+    free(mv->data);
+    mk->data = nk;
+    mv->data = nv;
+    mk->size = mv->size = out;
+    mk->capacity = mv->capacity = n + nobj;
+    map->index->size = 0;
+}
+
+static usize eytzinger_fill(FlatMap* map, usize i, usize k) {
+    if (k <= map->keys->size) {
+        usize ks = map->keys->objsize;
+        i = eytzinger_fill(map, i, 2 * k);
+        memcpy(map->index->data + (k * ks), map->keys->data + (i * ks), ks);
+        ((usize*)map->index_pos->data)[k] = i++;
+        i = eytzinger_fill(map, i, 2 * k + 1);
+    }
+    return i;
+}
+
+void flatmap_build_index(FlatMap* map) {
+    usize n = map->keys->size;
+    map->index->size = 0;
+    if (n == 0 || !ensure_capacity(map->index, n + 1) || !ensure_capacity(map->index_pos, n + 1))
+        return;
+    eytzinger_fill(map, 0, 1);
+    map->index->size = map->index_pos->size = n + 1;
+}
+
+// walks down the Eytzinger tree without branching on the comparisons, prefetching the 16 nodes 4 levels below
+#define EYTZINGER_DESCEND(type) {const type* t = (const type*)b; type x = *(const type*)key; \
+    while (k <= n) { PREFETCH(t + (k * 16)); k = 2 * k + (t[k] < x); }}
+
+void* flatmap_find(FlatMap* map, const void* key) {
+    usize n = map->keys->size, ks = map->keys->objsize;
+    if (n == 0)
+        return NULL;
+    ArrayUtilsComparator cmp = map->cmp;
+    usize pos;
+    if (map->index->size == n + 1) {
+        const uchar* b = map->index->data;
+        usize k = 1;
+        if (cmp == cmp_int32_arrayutils && ks == 4)
+            EYTZINGER_DESCEND(int32_t)
+        else if (cmp == cmp_uint32_arrayutils && ks == 4)
+            EYTZINGER_DESCEND(uint32_t)
+        else if (cmp == cmp_int64_arrayutils && ks == 8)
+            EYTZINGER_DESCEND(int64_t)
+        else if (cmp == cmp_uint64_arrayutils && ks == 8)
+            EYTZINGER_DESCEND(uint64_t)
+        else {
+            while (k <= n) {
+                PREFETCH(b + (k * 16 * ks));
+                k = 2 * k + (cmp(b + (k * ks), key) < 0);
+            }
+        }
+        // the trailing ones are the right turns taken after the last left turn, which was at the lower bound
+#ifdef __GNUC__
+        k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+#else
+        while (k & 1)
+            k >>= 1;
+        k >>= 1;
+#endif
+        if (k == 0 || cmp(b + (k * ks), key) != 0)
+            return NULL;
+        pos = ((usize*)map->index_pos->data)[k];
+    } else {
+        pos = gallop(map->keys->data, 0, n, ks, key, cmp, 0);
+        if (pos == n || cmp(map->keys->data + (pos * ks), key) != 0)
+            return NULL;
+    }
+    return map->values->data + (pos * map->values->objsize);
+}
+#undef EYTZINGER_DESCEND
+
+usize flatmap_size(FlatMap* map) {
+    return map->keys->size;
+}
+
+void flatmap_free(FlatMap* map) {
+    vector_free(map->keys);
+    vector_free(map->values);
+    vector_free(map->index);
+    vector_free(map->index_pos);
+}
+
 void print_vect(Vector* v, char* format) {
-    for (int i = 0; i < v->size; i++)
+    for (usize i = 0; i < v->size; i++)
         printf(format, *(v->data + (v->objsize * i)));
 }
 
 void print_vect_ptr(Vector* v, char* format) {
-    for (int i = 0; i < v->size; i++)
+    for (usize i = 0; i < v->size; i++)
         printf(format, *((void**)(v->data + (v->objsize * i))));        // this is horrible
 }
 
-void vector_free(Vector* v) {
+typedef enum StageKind {
+    StageMap,
+    StageFilter,
+    StageSkip,
+    StageTake,
+} StageKind;
+
+typedef struct Stage {
+    StageKind kind;
+    ArrayUtilsMapper map;
+    ArrayUtilsPredicate filter;
+    void* ctx;
+    usize count;        // objects still to skip or take
+    usize objsize;      // size of the objects coming out of this stage
+} Stage;
+
+// receives each block of objects coming out of the last stage
+typedef void (*BlockSink)(const uchar* objs, usize n, usize objsize, void* state);
+
+Pipeline pipeline_from(Vector* source) {
+    Pipeline p = {source, vector_new(sizeof(Stage)), source->objsize};
+    return p;
+}
+
+static void pipeline_add_stage(Pipeline* p, StageKind kind, ArrayUtilsMapper map, ArrayUtilsPredicate filter, void* ctx, usize count, usize objsize) {
+    Stage stage = {kind, map, filter, ctx, count, objsize};
+    add(p->stages, &stage);
+    p->objsize = objsize;
+}
+
+void pipeline_map(Pipeline* p, ArrayUtilsMapper fn, usize out_objsize, void* ctx) {
+    pipeline_add_stage(p, StageMap, fn, NULL, ctx, 0, out_objsize);
+}
+
+void pipeline_filter(Pipeline* p, ArrayUtilsPredicate fn, void* ctx) {
+    pipeline_add_stage(p, StageFilter, NULL, fn, ctx, 0, p->objsize);
+}
+
+void pipeline_skip(Pipeline* p, usize n) {
+    pipeline_add_stage(p, StageSkip, NULL, NULL, NULL, n, p->objsize);
+}
+
+void pipeline_take(Pipeline* p, usize n) {
+    pipeline_add_stage(p, StageTake, NULL, NULL, NULL, n, p->objsize);
+}
+
+void pipeline_free(Pipeline* p) {
+    if (p->stages != NULL)
+        vector_free(p->stages);
+    p->stages = NULL;
+}
+
+// upper bound of the objects the pipeline can produce
+static usize pipeline_bound(Pipeline* p) {
+    usize bound = p->source->size;
+    Stage* stages = (Stage*)p->stages->data;
+    for (usize s = 0; s < p->stages->size; s++) {
+        if (stages[s].kind == StageSkip)
+            bound = bound > stages[s].count ? bound - stages[s].count : 0;
+        else if (stages[s].kind == StageTake && stages[s].count < bound)
+            bound = stages[s].count;
+    }
+    return bound;
+}
+
+// pushes the source through all the stages a block at a time, blocks are sized so every stage's output stays in two cache resident buffers
+static usize pipeline_run(Pipeline* p, BlockSink sink, void* state) {
+    Stage* stages = (Stage*)p->stages->data;
+    usize nstages = p->stages->size, max_os = p->source->objsize, produced = 0;
+    for (usize s = 0; s < nstages; s++)
+        if (stages[s].objsize > max_os)
+            max_os = stages[s].objsize;
+    uchar local[2][PIPELINE_BLOCK];
+    uchar* scratch[2] = {local[0], local[1]};
+    usize block = max_os ? PIPELINE_BLOCK / max_os : PIPELINE_BLOCK;
+    if (block == 0) {
+        block = 1;
+        scratch[0] = safe_alloc(max_os);
+        scratch[1] = safe_alloc(max_os);
+    }
+    int done = 0;
+    for (usize base = 0; base < p->source->size && !done; base += block) {
+        const uchar* cur = p->source->data + (base * p->source->objsize);
+        usize n = p->source->size - base < block ? p->source->size - base : block;
+        usize os = p->source->objsize;
+        int which = 0;
+        for (usize s = 0; s < nstages && n > 0; s++) {
+            Stage* st = &stages[s];
+            switch (st->kind) {
+                case StageMap: {
+                    uchar* out = scratch[which];
+                    for (usize i = 0; i < n; i++)
+                        st->map(cur + (i * os), out + (i * st->objsize), st->ctx);
+                    cur = out;
+                    os = st->objsize;
+                    which ^= 1;
+                    break;
+                }
+                case StageFilter: {
+                    // the source is read only, so the first filter copies the survivors out, later ones compact in place
+                    uchar* out = cur == scratch[0] || cur == scratch[1] ? (uchar*)cur : scratch[which];
+                    usize kept = 0;
+                    for (usize i = 0; i < n; i++) {
+                        if (st->filter(cur + (i * os), st->ctx)) {
+                            if (out + (kept * os) != cur + (i * os))
+                                memcpy(out + (kept * os), cur + (i * os), os);
+                            kept++;
+                        }
+                    }
+                    if (out != cur)
+                        which ^= 1;
+                    cur = out;
+                    n = kept;
+                    break;
+                }
+                case StageSkip: {
+                    usize k = n < st->count ? n : st->count;
+                    st->count -= k;
+                    cur += k * os;
+                    n -= k;
+                    break;
+                }
+                case StageTake: {
+                    if (n > st->count)
+                        n = st->count;
+                    st->count -= n;
+                    if (st->count == 0)
+                        done = 1;
+                    break;
+                }
+            }
+        }
+        if (n > 0)
+            sink(cur, n, os, state);
+        produced += n;
+    }
+    if (scratch[0] != local[0]) {
+        free(scratch[0]);
+        free(scratch[1]);
+    }
+    pipeline_free(p);
+    return produced;
+}
+
+static void collect_sink(const uchar* objs, usize n, usize objsize, void* state) {
+    (void)objsize;
+    add_range_copy(state, (void*)objs, n);
+}
+
+usize pipeline_collect(Pipeline* p, Vector* dest) {
+    if (dest->objsize != p->objsize) {
+        handle_err(ObjectSizeMismatchError, "Pipeline output doesn't match the objsize of the destination");
+        pipeline_free(p);
+        return 0;
+    }
+    usize bound = pipeline_bound(p);
+    if (bound > (usize)-1 - dest->size) {
+        handle_err(SizeOverflowError, "Vector size overflows size_t");
+        pipeline_free(p);
+        return 0;
+    }
+    vector_reserve(dest, dest->size + bound);
+    return pipeline_run(p, collect_sink, dest);
+}
+
+typedef struct ReduceState {
+    void* acc;
+    ArrayUtilsReducer fn;
+    void* ctx;
+} ReduceState;
+
+static void reduce_sink(const uchar* objs, usize n, usize objsize, void* state) {
+    ReduceState* rs = state;
+    for (usize i = 0; i < n; i++)
+        rs->fn(rs->acc, objs + (i * objsize), rs->ctx);
+}
+
+usize pipeline_reduce(Pipeline* p, void* acc, ArrayUtilsReducer fn, void* ctx) {
+    ReduceState rs = {acc, fn, ctx};
+    return pipeline_run(p, reduce_sink, &rs);
+}
+
+// header of a packed block, values are v[0] = first and v[i] = v[i - 1] + min_delta + packed[i] (modulo 2^64)
+typedef struct PackedBlock {
+    int64_t first;
+    int64_t min;
+    int64_t max;
+    uint64_t min_delta;
+    uint64_t offset;    // index of the first word of the block in words
+    uint32_t bits;
+    uint32_t reserved;
+} PackedBlock;
+
+// the 128 packed values are split in 4 lanes (value i goes to lane i % 4), each lane is a stream of bits words
+// and the words of the lanes are interleaved, so that SSE2 can unpack 4 values at a time
+static void pack_block(const uint64_t* in, uint32_t bits, uint32_t* out) {
+    memset(out, 0, 4 * bits * sizeof(uint32_t));
+    for (usize i = 0; i < PACKED_BLOCK; i++) {
+        usize lane = i % 4, pos = (i / 4) * bits, k = pos / 32, off = pos % 32;
+        uint64_t v = in[i];
+        for (usize put = 0; put < bits; k++, off = 0) {
+            out[(k * 4) + lane] |= (uint32_t)(v << off);
+            put += 32 - off;
+            v = put < 64 ? in[i] >> put : 0;
+        }
+    }
+}
+
+static void unpack_block_scalar(const uint32_t* in, uint32_t bits, uint64_t* out) {
+    uint64_t mask = bits == 64 ? ~(uint64_t)0 : ((uint64_t)1 << bits) - 1;
+    for (usize i = 0; i < PACKED_BLOCK; i++) {
+        usize lane = i % 4, pos = (i / 4) * bits, k = pos / 32, off = pos % 32;
+        uint64_t v = in[(k * 4) + lane] >> off;
+        for (usize got = 32 - off; got < bits; got += 32)
+            v |= (uint64_t)in[(++k * 4) + lane] << got;
+        out[i] = v & mask;
+    }
+}
+
+#if defined(__SSE2__)
+// unpacks 4 values per step for widths up to 32 bits
+static void unpack_block_sse2(const uint32_t* in, uint32_t bits, uint64_t* out) {
+    uint32_t tmp[PACKED_BLOCK];
+    __m128i mask = _mm_set1_epi32(bits == 32 ? -1 : (int)((1u << bits) - 1));
+    __m128i cur = _mm_loadu_si128((const __m128i*)in);
+    uint32_t shift = 0;
+    for (usize j = 0; j < PACKED_BLOCK / 4; j++) {
+        __m128i v = _mm_srl_epi32(cur, _mm_cvtsi32_si128((int)shift));
+        shift += bits;
+        if (shift >= 32) {
+            shift -= 32;
+            in += 4;
+            if (j + 1 < PACKED_BLOCK / 4 || shift > 0)
+                cur = _mm_loadu_si128((const __m128i*)in);
+            if (shift > 0)
+                v = _mm_or_si128(v, _mm_sll_epi32(cur, _mm_cvtsi32_si128((int)(bits - shift))));
+        }
+        _mm_storeu_si128((__m128i*)(tmp + (j * 4)), _mm_and_si128(v, mask));
+    }
+    for (usize i = 0; i < PACKED_BLOCK; i++)
+        out[i] = tmp[i];
+}
+#endif
+
+// decodes the 128 values of block b into out
+static void decode_block(PackedIntVector* p, const PackedBlock* b, int64_t* out) {
+    uint64_t r[PACKED_BLOCK];
+    const uint32_t* in = (const uint32_t*)p->words->data + b->offset;
+    if (b->bits == 0)
+        memset(r, 0, sizeof(r));
+#if defined(__SSE2__)
+    else if (b->bits <= 32)
+        unpack_block_sse2(in, b->bits, r);
+#endif
+    else
+        unpack_block_scalar(in, b->bits, r);
+    uint64_t v = (uint64_t)b->first;
+    out[0] = b->first;
+    for (usize i = 1; i < PACKED_BLOCK; i++) {
+        v += b->min_delta + r[i];
+        out[i] = (int64_t)v;
+    }
+}
+
+// packs the full tail into a new block
+static void flush_tail(PackedIntVector* p) {
+    const int64_t* v = (const int64_t*)p->tail->data;
+    uint64_t r[PACKED_BLOCK];
+    PackedBlock b = {v[0], v[0], v[0], 0, p->words->size, 0, 0};
+    int64_t min_delta = INT64_MAX;
+    for (usize i = 1; i < PACKED_BLOCK; i++) {
+        int64_t d = (int64_t)((uint64_t)v[i] - (uint64_t)v[i - 1]);
+        if (d < min_delta)
+            min_delta = d;
+        if (v[i] < b.min)
+            b.min = v[i];
+        if (v[i] > b.max)
+            b.max = v[i];
+    }
+    b.min_delta = (uint64_t)min_delta;
+    uint64_t max_r = 0;
+    r[0] = 0;
+    for (usize i = 1; i < PACKED_BLOCK; i++) {
+        r[i] = (uint64_t)v[i] - (uint64_t)v[i - 1] - b.min_delta;
+        max_r |= r[i];
+    }
+    while (b.bits < 64 && (max_r >> b.bits) != 0)
+        b.bits++;
+    if (!grow_by(p->words, 4 * b.bits) || !grow_by(p->blocks, 1))
+        return;
+    pack_block(r, b.bits, (uint32_t*)p->words->data + b.offset);
+    p->words->size += 4 * b.bits;
+    add(p->blocks, &b);
+    p->tail->size = 0;
+}
+
+PackedIntVector packedint_new() {
+    PackedIntVector p = {vector_new(sizeof(PackedBlock)), vector_new(sizeof(uint32_t)), vector_fromsize(sizeof(int64_t), PACKED_BLOCK)};
+    return p;
+}
+
+void packedint_add(PackedIntVector* p, int64_t value) {
+    add(p->tail, &value);
+    if (p->tail->size == PACKED_BLOCK)
+        flush_tail(p);
+}
+
+void packedint_add_range(PackedIntVector* p, const int64_t* values, usize nobj) {
+    while (nobj > 0) {
+        usize n = PACKED_BLOCK - p->tail->size;
+        if (n > nobj)
+            n = nobj;
+        add_range_copy(p->tail, (void*)values, n);
+        values += n;
+        nobj -= n;
+        if (p->tail->size == PACKED_BLOCK)
+            flush_tail(p);
+    }
+}
+
+usize packedint_size(PackedIntVector* p) {
+    return p->blocks->size * PACKED_BLOCK + p->tail->size;
+}
+
+usize packedint_bytes(PackedIntVector* p) {
+    return p->blocks->size * sizeof(PackedBlock) + p->words->size * sizeof(uint32_t) + p->tail->size * sizeof(int64_t);
+}
+
+int64_t packedint_get(PackedIntVector* p, usize i) {
+    usize block = i / PACKED_BLOCK;
+    if (block >= p->blocks->size)
+        return *(int64_t*)access(p->tail, i - (p->blocks->size * PACKED_BLOCK));
+    int64_t out[PACKED_BLOCK];
+    decode_block(p, (const PackedBlock*)p->blocks->data + block, out);
+    return out[i % PACKED_BLOCK];
+}
+
+void packedint_decode(PackedIntVector* p, Vector* dest) {
+    if (dest->objsize != sizeof(int64_t)) {
+        handle_err(ObjectSizeMismatchError, "Packed vector can only be decoded into a vector of objsize 8");
+        return;
+    }
+    if (!grow_by(dest, packedint_size(p)))
+        return;
+    const PackedBlock* blocks = (const PackedBlock*)p->blocks->data;
+    for (usize b = 0; b < p->blocks->size; b++) {
+        decode_block(p, &blocks[b], (int64_t*)dest->data + dest->size);
+        dest->size += PACKED_BLOCK;
+    }
+    add_range_copy(dest, p->tail->data, p->tail->size);
+}
+
+// index of the first value equal to value from block start on, counting all of them in count if it isn't NULL
+static usize packed_search(PackedIntVector* p, int64_t value, usize* count) {
+    const PackedBlock* blocks = (const PackedBlock*)p->blocks->data;
+    const int64_t* tail = (const int64_t*)p->tail->data;
+    int64_t out[PACKED_BLOCK];
+    usize first = ARRAYUTILS_NPOS;
+    for (usize b = 0; b < p->blocks->size; b++) {
+        if (value < blocks[b].min || value > blocks[b].max)
+            continue;
+        if (blocks[b].min == blocks[b].max) {
+            if (first == ARRAYUTILS_NPOS)
+                first = b * PACKED_BLOCK;
+            if (count == NULL)
+                return first;
+            *count += PACKED_BLOCK;
+            continue;
+        }
+        decode_block(p, &blocks[b], out);
+        for (usize i = 0; i < PACKED_BLOCK; i++) {
+            if (out[i] != value)
+                continue;
+            if (first == ARRAYUTILS_NPOS)
+                first = b * PACKED_BLOCK + i;
+            if (count == NULL)
+                return first;
+            (*count)++;
+        }
+    }
+    for (usize i = 0; i < p->tail->size; i++) {
+        if (tail[i] != value)
+            continue;
+        if (first == ARRAYUTILS_NPOS)
+            first = p->blocks->size * PACKED_BLOCK + i;
+        if (count == NULL)
+            return first;
+        (*count)++;
+    }
+    return first;
+}
+
+usize packedint_count(PackedIntVector* p, int64_t value) {
+    usize count = 0;
+    packed_search(p, value, &count);
+    return count;
+}
+
+int packedint_any_match(PackedIntVector* p, int64_t value, usize* n) {
+    *n = packed_search(p, value, NULL);
+    return *n != ARRAYUTILS_NPOS;
+}
+
+// serialized layout: magic, then the number of blocks, words and tail values as uint64_t, then the three buffers as they are in memory
+void packedint_serialize(PackedIntVector* p, Vector* out) {
+    if (out->objsize != 1) {
+        handle_err(ObjectSizeMismatchError, "Packed vector can only be serialized into a vector of objsize 1");
+        return;
+    }
+    uint32_t magic = PACKED_MAGIC;
+    uint64_t counts[3] = {p->blocks->size, p->words->size, p->tail->size};
+    if (!grow_by(out, sizeof(magic) + sizeof(counts) + packedint_bytes(p)))
+        return;
+    add_range_copy(out, &magic, sizeof(magic));
+    add_range_copy(out, counts, sizeof(counts));
+    add_range_copy(out, p->blocks->data, p->blocks->size * sizeof(PackedBlock));
+    add_range_copy(out, p->words->data, p->words->size * sizeof(uint32_t));
+    add_range_copy(out, p->tail->data, p->tail->size * sizeof(int64_t));
+}
+
+PackedIntVector packedint_deserialize(const void* buf, usize len) {
+    PackedIntVector p = packedint_new();
+    const uchar* in = buf;
+    uint32_t magic;
+    uint64_t counts[3];
+    if (len < sizeof(magic) + sizeof(counts)) {
+        handle_err(CorruptDataError, "Serialized packed vector is truncated");
+        return p;
+    }
+    memcpy(&magic, in, sizeof(magic));
+    memcpy(counts, in + sizeof(magic), sizeof(counts));
+    in += sizeof(magic) + sizeof(counts);
+    len -= sizeof(magic) + sizeof(counts);
+    usize sizes[3] = {sizeof(PackedBlock), sizeof(uint32_t), sizeof(int64_t)};
+    Vector* parts[3] = {p.blocks, p.words, p.tail};
+    if (magic != PACKED_MAGIC || counts[2] >= PACKED_BLOCK) {
+        handle_err(CorruptDataError, "Not a serialized packed vector");
+        return p;
+    }
+    // all the counts are checked against len before anything is copied, so an error leaves p empty
+    usize left = len;
+    for (int k = 0; k < 3; k++) {
+        if (counts[k] > left / sizes[k]) {
+            handle_err(CorruptDataError, "Serialized packed vector is truncated");
+            return p;
+        }
+        left -= (usize)counts[k] * sizes[k];
+    }
+    for (int k = 0; k < 3; k++) {
+        add_range_copy(parts[k], (void*)in, (usize)counts[k]);
+        in += counts[k] * sizes[k];
+    }
+    // every block must point inside the words that were read
+    const PackedBlock* blocks = (const PackedBlock*)p.blocks->data;
+    for (usize b = 0; b < p.blocks->size; b++) {
+        if (blocks[b].bits > 64 || blocks[b].offset > p.words->size || 4 * (uint64_t)blocks[b].bits > p.words->size - blocks[b].offset) {
+            handle_err(CorruptDataError, "Serialized packed vector has an invalid block");
+            for (int k = 0; k < 3; k++)
+                parts[k]->size = 0;
+            return p;
+        }
+    }
+    return p;
+}
+
+void packedint_free(PackedIntVector* p) {
+    vector_free(p->blocks);
+    vector_free(p->words);
+    vector_free(p->tail);
+}
+
+static usize value_type_size(ArrayUtilsValueType type) {
+    switch (type) {
+        case ValueInt8:
+        case ValueUInt8:
+            return 1;
+        case ValueInt16:
+        case ValueUInt16:
+            return 2;
+        case ValueInt32:
+        case ValueUInt32:
+        case ValueFloat:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+// buffered destination of the text writers, either a FILE* or (if f is NULL) a file descriptor
+typedef struct TextSink {
+    FILE* f;
+    int fd;
+    char* buf;
+    usize len;
+    usize written;
+    int failed;
+} TextSink;
+
+static void sink_flush(TextSink* sink) {
+    usize off = 0;
+    if (sink->failed)
+        return;
+    if (sink->f != NULL) {
+        off = fwrite(sink->buf, 1, sink->len, sink->f);
+    } else {
+#ifdef ARRAYUTILS_POSIX
+        while (off < sink->len) {
+            ssize_t n = write(sink->fd, sink->buf + off, sink->len - off);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break;
+            off += (usize)n;
+        }
+#endif
+    }
+    sink->written += off;
+    if (off != sink->len) {
+        sink->failed = 1;
+        handle_err(IOError, "Error while writing vector as text");
+    }
+    sink->len = 0;
+}
+
+static const char digit_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+static char* format_u64(char* p, uint64_t val) {
+    char tmp[20];
+    char* end = tmp + sizeof(tmp);
+    char* q = end;
+    while (val >= 100) {
+        q -= 2;
+        memcpy(q, digit_pairs + ((val % 100) * 2), 2);
+        val /= 100;
+    }
+    if (val >= 10) {
+        q -= 2;
+        memcpy(q, digit_pairs + (val * 2), 2);
+    } else {
+        *--q = (char)('0' + val);
+    }
+    memcpy(p, q, (usize)(end - q));
+    return p + (end - q);
+}
+
+static char* format_i64(char* p, int64_t val) {
+    if (val < 0) {
+        *p++ = '-';
+        return format_u64(p, (uint64_t)0 - (uint64_t)val);
+    }
+    return format_u64(p, (uint64_t)val);
+}
+
+// Schubfach (R. Giulietti, "The Schubfach way to render doubles"): finds the shortest decimal inside the rounding interval of a binary value
+// schubfach_g[k - SCHUBFACH_K_MIN] = floor(10^-k * 2^(125 - floor(log2(10^-k)))) + 1, split as {bits 126..63, bits 62..0}
+static const uint64_t schubfach_g[][2] = {
+    {0x4f0cedc95a718dd4, 0x5b01e8b09aa0d1b5}, {0x7e7b160ef71c1621, 0x119ca780f767b5ee},
+    {0x652f44d8c5b011b4, 0x0e16ec672c52f7f2}, {0x50f29d7a37c00e29, 0x581256b8f0425ff5},
+    {0x40c21794f96671ba, 0x79a84560c0351991}, {0x679cf287f570b5f7, 0x75da089acd21c281},
+    {0x52e3f5399126f7f9, 0x44ae6d48a41b0201}, {0x424ff76140ebf994, 0x36f1f106e9af34cd},
+    {0x6a198bcece465c20, 0x57e981a4a918547b}, {0x54e13ca571d1e34d, 0x2cbace1d541376c9},
+    {0x43e763b78e4182a4, 0x23c8a4e44342c56e}, {0x6ca56c58e39c043a, 0x060dd4a06b9e08b0},
+    {0x56eabd13e9499cfb, 0x1e7176e6bc7e6d59}, {0x458897432107b0c8, 0x7ec12bebc9febde1},
+    {0x6f40f20501a5e7a7, 0x7e01dfdfa9979635}, {0x5900c19d9aeb1fb9, 0x4b34b319547944f7},
+    {0x4733ce17af227fc7, 0x55c3c27aa9fa9d93}, {0x71ec7cf2b1d0cc72, 0x560603f7765dc8ea},
+    {0x5b2397288e40a38e, 0x7804cff92b7e3a55}, {0x48e945ba0b66e93f, 0x13370cc755fe9511},
+    {0x74a86f90123e41fe, 0x51f1ae0bbcca881b}, {0x5d538c7341cb67fe, 0x74c1580963d539af},
+    {0x4aa93d29016f8665, 0x43cde0078310faf3}, {0x77752ea8024c0a3c, 0x0616333f381b2b1e},
+    {0x5f90f22001d66e96, 0x3811c298f9af55b1}, {0x4c73f4e667debede, 0x600e35472e25de28},
+    {0x7a532170a6313164, 0x3349eed849d6303f}, {0x61dc1ac084f42783, 0x42a18be03b11c033},
+    {0x4e49af006a5cec69, 0x1bb46fe695a7ccf5}, {0x7d42b19a43c7e0a8, 0x2c53e63dbc3fae55},
+    {0x64355ae1cfd31a20, 0x237651cafcffbeaa}, {0x502aaf1b0ca8e1b3, 0x35f8416f30cc9888},
+    {0x402225af3d53e7c2, 0x5e603458f3d6e06d}, {0x669d0918621fd937, 0x4a3386f4b957cd7b},
+    {0x52173a79e8197a92, 0x6e8f9f2a2ddfd796}, {0x41ac2ec7ece12edb, 0x720c7f54f17fdfab},
+    {0x69137e0cae3517c6, 0x1ce0cbbb1bffcc45}, {0x540f980a24f74638, 0x171a3c95afffd69e},
+    {0x433facd4ea5f6b60, 0x127b63aaf3331218}, {0x6b991487dd657899, 0x6a5f05de51eb5026},
+    {0x5614106cb11dfa14, 0x5518d17ea7ef7352}, {0x44dcd9f08db194dd, 0x2a7a41321ff2c2a8},
+    {0x6e2e2980e2b5bafb, 0x5d906850331e043f}, {0x5824ee00b55e2f2f, 0x647386a68f4b3699},
+    {0x4683f19a2ab1bf59, 0x36c2d21ed908f87b}, {0x70d31c29dde93228, 0x579e1cfe280e5a5d},
+    {0x5a427cee4b20f4ed, 0x2c7e7d98200b7b7e}, {0x483530bea280c3f1, 0x09fecae019a2c932},
+    {0x73884dfdd0ce064e, 0x43314499c29e0eb6}, {0x5c6d0b3173d8050b, 0x4f5a9d47cee4d891},
+    {0x49f0d5c129799da2, 0x72aee4397250ad41}, {0x764e22cea8c295d1, 0x377e39f583b44868},
+    {0x5ea4e8a553cede41, 0x12cb61913629d387}, {0x4bb72084430be500, 0x756f8140f8217605},
+    {0x792500d39e796e67, 0x6f18cece59cf233c}, {0x60ea670fb1fabeb9, 0x3f470bd847d8e8fd},
+    {0x4d885272f4c89894, 0x329f3cad064720ca}, {0x7c0d50b7ee0dc0ed, 0x37652de1a3a50143},
+    {0x633dda2cbe716724, 0x2c50f1814fb73436}, {0x4f64ae8a31f45283, 0x3d0d8e010c92902b},
+    {0x7f077da9e986ea6b, 0x7b48e334e0ea8045}, {0x659f97bb2138bb89, 0x49071c2a4d88669d},
+    {0x514c796280fa2fa1, 0x20d27ceea46d1ee4}, {0x4109fab533fb594d, 0x670eca58838a7f1d},
+    {0x680ff788532bc216, 0x0b4add5a6c10cb62}, {0x533ff939dc2301ab, 0x22a24aaebcda3c4e},
+    {0x4299942e49b59aef, 0x354ea22563e1c9d8}, {0x6a8f537d42bc2b18, 0x554a9d089fcfa95a},
+    {0x553f75fdcefcef46, 0x776ee406e63fbaae}, {0x4432c4cb0bfd8c38, 0x5f8be99f1e996225},
+    {0x6d1e07ab466279f4, 0x327975cb64289d08}, {0x574b3955d1e86190, 0x28612b091ced4a6d},
+    {0x45d5c777db204e0d, 0x06b4226db0bdd524}, {0x6fbc72595e9a167b, 0x24536a491ac95506},
+    {0x59638eade54811fc, 0x1d0f883a7bd44405}, {0x4782d88b1dd34196, 0x4a72d361fca9d004},
+    {0x726af411c952028a, 0x43eaebcffaa94cd3}, {0x5b88c3416ddb353b, 0x4fef230cc88770a9},
+    {0x493a35cdf17c2a96, 0x0cbf4f3d6d3926ee}, {0x7529efafe8c6aa89, 0x61321862485b717c},
+    {0x5dbb262653d22207, 0x675b46b506af8dfd}, {0x4afc1e850fdb4e6c, 0x52af6bc405593e64},
+    {0x77f9ca6e7fc54a47, 0x377f12d33bc1fd6d}, {0x5ffb085866376e9f, 0x45ff42429634cabd},
+    {0x4cc8d379eb5f8bb2, 0x6b329b68782a3bcb}, {0x7adaebf64565ac51, 0x2b842bda59dd2c77},
+    {0x6248bcc5045156a7, 0x3c69bcaeae4a89f9}, {0x4ea0970403744552, 0x6387ca25583ba194},
+    {0x7dcdbe6cd253a21e, 0x05a6103bc05f68ed}, {0x64a498570ea94e7e, 0x37b80cfc99e5ed8a},
+    {0x5083ad1272210b98, 0x2c933d96e184be08}, {0x40695741f4e73c79, 0x7075cadf1ad09807},
+    {0x670ef2032171fa5c, 0x4d8944982ae759a4}, {0x52725b35b45b2eb0, 0x3e076a135585e150},
+    {0x41f515c49048f226, 0x64d2bb42aad1810d}, {0x698822d41a0e503e, 0x07b7920444826815},
+    {0x546ce8a9ae71d9cb, 0x1fc60e69d0685344}, {0x438a53baf1f4ae3c, 0x196b3ebb0d20429d},
+    {0x6c1085f7e9877d2d, 0x0f11fdf815006a94}, {0x56739e5fee05fdbd, 0x58db319344005543},
+    {0x45294b7ff19e6497, 0x60af5adc3666aa9c}, {0x6ea878ccb5ca3a8c, 0x344bc4938a3dddc7},
+    {0x5886c70a2b082ed6, 0x5d096a0fa1cb17d2}, {0x46d238d4ef39bf12, 0x173abb3fb4a27975},
+    {0x71505aee4b8f981d, 0x0b912b992103f588}, {0x5aa6af25093face4, 0x0940efadb4032ad3},
+    {0x488558ea6dcc8a50, 0x07672624900288a9}, {0x74088e43e2e0dd4c, 0x723ea36db337410e},
+    {0x5cd3a5031be71770, 0x5b654f8af5c5cda5}, {0x4a42ea68e31f45f3, 0x62b772d5916b0aeb},
+    {0x76d1770e38320986, 0x0458b7bc1bde77dd}, {0x5f0df8d82cf4d46b, 0x1d13c630164b9318},
+    {0x4c0b2d79bd90a9ef, 0x30dc9e8cdea2dc13}, {0x79ab7bf5fc1aa97f, 0x0160fdae31049351},
+    {0x6155fcc4c9aeedff, 0x1ab3fe24f403a90e}, {0x4dde63d0a158be65, 0x6229981d9002eda5},
+    {0x7c97061a9bc130a2, 0x69dc2695b337e2a1}, {0x63ac04e2163426e8, 0x54b01ede28f9821b},
+    {0x4fbcd0b4de901f20, 0x43c018b1ba6134e2}, {0x7f9481216419cb67, 0x1f99c11c5d68549d},
+    {0x6610674de9ae3c52, 0x4c7b00e37ded107e}, {0x51a6b90b21583042, 0x09fc00b5fe574065},
+    {0x41522da2811359ce, 0x3b3000919845cd1d}, {0x68837c3734ebc2e3, 0x784ccdb5c06fae95},
+    {0x539c635f5d8968b6, 0x2d0a3e2b00595877}, {0x42e382b2b13aba2b, 0x3da1cb5599e11393},
+    {0x6b059deab52ac378, 0x629c7888f634ec1e}, {0x559e17eef755692d, 0x3549fa072b5d89b1},
+    {0x447e798bf91120f1, 0x1107fb38ef7e07c1}, {0x6d9728dff4e834b5, 0x01a65ec17f300c68},
+    {0x57ac20b32a535d5d, 0x4e1eb23465c009ed}, {0x46234d5c21dc4ab1, 0x24e55b5d1e333b24},
+    {0x70387bc69c93aab5, 0x216ef894fd1ec506}, {0x59c6c96bb076222a, 0x4df2607730e56a6c},
+    {0x47d23abc8d2b4e88, 0x3e5b805f5a5121f0}, {0x72e9f79415121740, 0x63c59a322a1b697f},
+    {0x5bee5fa9aa74df67, 0x03047b5b54e2bacc}, {0x498b7fbaeec3e5ec, 0x0269fc4910b5623d},
+    {0x75abff917e063cac, 0x6a432d41b45569fb}, {0x5e2332dacb38308a, 0x21cf5767c37787fc},
+    {0x4b4f5be23c2cf3a1, 0x67d912b9692c6cca}, {0x787ef969f9e185cf, 0x595b5128a8471476},
+    {0x60659454c7e79e3f, 0x6115da86ed05a9f8}, {0x4d1e1043d31fb1cc, 0x4dab1538bd9e2193},
+    {0x7b634d3951cc4fad, 0x62ab552795c9cf52}, {0x62b5d7610e3d0c8b, 0x0222aa86116e3f75},
+    {0x4ef7df80d830d6d5, 0x4e822204dabe992a}, {0x7e59659af38157bc, 0x17369cd49130f510},
+    {0x65145148c2cddfc9, 0x5f5ee3dd40f3f740}, {0x50dd0dd3cf0b196e, 0x1918b64a9a5cc5cd},
+    {0x40b0d7dca5a27abe, 0x4746f83baeb09e3e}, {0x678159610903f797, 0x253e59f91780fd2f},
+    {0x52cde11a6d9cc612, 0x50feae60df9a6426}, {0x423e4daebe1704db, 0x5a65584d7faeb685},
+    {0x69fd4917968b3af9, 0x10a226e265e4573b}, {0x54caa0dfaba29594, 0x0d4e8581eb1d1295},
+    {0x43d54d7fbc821143, 0x243ed134bc174211}, {0x6c887bff94034ed2, 0x06cae85460253682},
+    {0x56d396661002a574, 0x6bd586a9e6842b9b}, {0x457611eb40021df7, 0x09779eee52035616},
+    {0x6f234fdeccd02ff1, 0x5bf297e3b66bbcef}, {0x58e90cb23d73598e, 0x165bacb62b8963f3},
+    {0x4720d6f4fdf5e13e, 0x451623c4efa11cc2}, {0x71ce24bb2fefceca, 0x3b569fa17f682e03},
+    {0x5b0b5095bff30bd5, 0x15dee61acc535803}, {0x48d5da11665c0977, 0x2b18b8157042accf},
+    {0x74895ce8a3c6758b, 0x5e8df355806aae18}, {0x5d3ab0ba1c9ec46f, 0x653e5c4466bbbe7a},
+    {0x4a955a2e7d4bd059, 0x3765169d1efc9861}, {0x77555d172edfb3c2, 0x256e8a94fe60f3cf},
+    {0x5f777dac257fc301, 0x6abed543feb3f63f}, {0x4c5f97bceacc9c01, 0x3bcbddcffef65e99},
+    {0x7a328c6177adc668, 0x5fac961997f0975b}, {0x61c209e792f16b86, 0x7fbd44e1465a12af},
+    {0x4e34d4b9425abc6b, 0x7fca9d810514dbbf}, {0x7d21545b9d5dfa46, 0x32ddc8ce6e87c5ff},
+    {0x641aa9e2e44b2e9e, 0x5be4a0a525396b32}, {0x501554b5836f587e, 0x7cb6e6ea842def5c},
+    {0x4011109135f2ad32, 0x30925255368b25e3}, {0x6681b41b89844850, 0x4db6ea21f0dea304},
+    {0x52015ce2d469d373, 0x57c5881b2718826a}, {0x419ab0b576bb0f8f, 0x5fd139af527a01ef},
+    {0x68f781225791b27f, 0x4c81f5e550c3364a}, {0x53f9341b79415b99, 0x239b2b1dda35c508},
+    {0x432dc3492dcde2e1, 0x02e288e4ae916a6d}, {0x6b7c6ba849496b01, 0x516a74a1174f10ae},
+    {0x55fd22ed076def34, 0x4121f6e745d8da25}, {0x44ca82573924bf5d, 0x1a8192529e4714eb},
+    {0x6e10d08b8ea1322e, 0x5d9c1d50fd3e87dd}, {0x580d73a2d880f4f2, 0x17b01773fdcb9fe4},
+    {0x4671294f139a5d8e, 0x4626792997d61984}, {0x70b50ee4ec2a2f4a, 0x3d0a5b75bfbcf59f},
+    {0x5a2a7250bcee8c3b, 0x4a6eaf916630c47f}, {0x4821f50d63f209c9, 0x21f2260deb5a36cc},
+    {0x736988156cb6760e, 0x69837016455d247a}, {0x5c546cddf091f80b, 0x6e02c011d1175062},
+    {0x49dd23e4c074c66f, 0x719bccdb0dac404e}, {0x762e9fd467213d7f, 0x68f947c4e2ad33b0},
+    {0x5e8bb3105280fdff, 0x6d94396a4ef0f627}, {0x4ba2f5a6a8673199, 0x3e102deea58d91b9},
+    {0x7904bc3dda3eb5c2, 0x3019e3176f48e927}, {0x60d09697e1cbc49b, 0x4014b5ac590720ec},
+    {0x4d73abacb4a303af, 0x4cdd5e237a6c1a57}, {0x7bec45e12104d2b2, 0x47c8969f2a46908a},
+    {0x63236b1a80d0a88e, 0x6ca0787f5505406f}, {0x4f4f88e200a6ed3f, 0x0a19f9ff773766bf},
+    {0x7ee5a7d0010b1531, 0x5cf65ccbf1f23dfe}, {0x6584864000d5aa8e, 0x172b7d6ff4c1cb32},
+    {0x5136d1cccd77bba4, 0x78ef978cc3ce3c28}, {0x40f8a7d70ac62fb7, 0x13f2dfa3cfd83020},
+    {0x67f43fbe77a37f8b, 0x398499061959e699}, {0x5329cc985fb5ffa2, 0x6136e0d1ade18548},
+    {0x4287d6e04c91994f, 0x00f8b3daf181376d}, {0x6a72f166e0e8f54b, 0x1b27862b1c01f247},
+    {0x5528c11f1a53f76f, 0x2f52d1bc1667f506}, {0x44209a7f48432c59, 0x0c424163451ff738},
+    {0x6d00f7320d3846f4, 0x7a039bd208332526}, {0x5733f8f4d76038c3, 0x7b361641a028ea85},
+    {0x45c32d90ac4cfa36, 0x2f5e78348020bb9e}, {0x6f9eaf4de07b29f0, 0x4bca59ed99cdf8fc},
+    {0x594bbf71806287f3, 0x563b7b247b0b2d96}, {0x476fcc5acd1b9ff6, 0x11c92f50626f57ac},
+    {0x724c7a2ae1c5ccbd, 0x02db7ee703e55912}, {0x5b7061bbe7d17097, 0x1be2cbec031de0dc},
+    {0x4926b496530df3ac, 0x164f09899c17e716}, {0x750aba8a1e7cb913, 0x3d4b4275c68ca4f0},
+    {0x5da22ed4e530940f, 0x4aa29b916ba3b726}, {0x4ae825771dc07672, 0x6ee87c74561c9285},
+    {0x77d9d58b62cd8a51, 0x3173fa53bcfa8408}, {0x5fe177a2b5713b74, 0x278ffb7630c869a0},
+    {0x4cb45fb55df42f90, 0x1fa662c4f3d387b3}, {0x7aba32bbc986b280, 0x32a3d13b1fb8d91f},
+    {0x622e8efca1388ecd, 0x0ee9742f4c93e0e6}, {0x4e8ba596e760723d, 0x58bac3590a0fe71e},
+    {0x7dac3c24a5671d2f, 0x412ad228101971c9}, {0x6489c9b6eab8e426, 0x00ef0e8673478e3b},
+    {0x506e3af8bbc71ceb, 0x1a58d86b8f6c71c9}, {0x40582f2d6305b0bc, 0x1513e0560c56c16e},
+    {0x66f37eaf04d5e793, 0x3b530089ad579be2}, {0x525c6558d0ab1fa9, 0x15dc006e2446164f},
+    {0x41e384470d55b2ed, 0x5e4999f1b69e783f}, {0x696c06d81555eb15, 0x7d428fe92430c065},
+    {0x54566be0111188de, 0x31020cba835a3384}, {0x4378564cda746d7e, 0x5a680a2ecf7b5c69},
+    {0x6bf3bd47c3ed7bfd, 0x770cdd17b25efa42}, {0x565c976c9cbdfccb, 0x1270b0dfc1e59502},
+    {0x4516df8a16fe63d5, 0x5b8d5a4c9b1e10ce}, {0x6e8aff4357fd6c89, 0x127bc3adc4fce7b0},
+    {0x586f329c466456d4, 0x0ec96957d0ca52f3}, {0x46bf5bb038504576, 0x3f07877973d50f29},
+    {0x71322c4d26e6d58a, 0x31a5a58f1fbb4b75}, {0x5a8e89d75252446e, 0x5aeaead8e62f6f91},
+    {0x487207df750e9d25, 0x2f22557a51bf8c74}, {0x73e9a63254e42ea2, 0x1836ef2a1c65ad86},
+    {0x5cbaeb5b771cf21b, 0x2cf8bf54e3848ad2}, {0x4a2f22af927d8e7c, 0x23fa32aa4f9d3bdb},
+    {0x76b1d118ea627d93, 0x5329eaaa18fb92f8}, {0x5ef4a74721e86476, 0x0f54bbbb472fa8c6},
+    {0x4bf6ec38e7ed1d2b, 0x25dd62fc38f2ed6c}, {0x798b138e3fe1c845, 0x22fbd1938e517bdf},
+    {0x613c0fa4ffe7d36a, 0x4f2fdadc71dac97f}, {0x4dc9a61d998642bb, 0x58f3157d27e23acc},
+    {0x7c75d695c2706ac5, 0x74b82261d969f7ad}, {0x63917877cec0556b, 0x10934eb4adee5fbe},
+    {0x4fa793930bcd1122, 0x4075d8908b251965}, {0x7f7285b812e1b504, 0x00bc8db411d4f56e},
+    {0x65f537c675815d9c, 0x66fd3e29a7dd9125}, {0x5190f96b91344ae3, 0x6bfdcb54864ada84},
+    {0x4140c78940f6a24f, 0x6ffe3c439ea2486a}, {0x6867a5a867f103b2, 0x7ffd2d38fdd073dc},
+    {0x53861e2053273628, 0x6664242d97d9f64a}, {0x42d1b1b375b8f820, 0x51e9b68adfe191d5},
+    {0x6ae91c5255f4c034, 0x1ca924116635b621}, {0x558749db77f70029, 0x63ba83411e915e81},
+    {0x446c3b15f9926687, 0x6962029a7edab201}, {0x6d79f82328ea3da6, 0x0f03375d97c45001},
+    {0x5794c6828721caeb, 0x259c2c4adfd04001}, {0x46109eced2816f22, 0x5149bd08b30d0001},
+    {0x701a97b150cf1837, 0x3542c80deb480001}, {0x59aedfc10d7279c5, 0x7768a00b22a00001},
+    {0x47bf19673df52e37, 0x79208008e8800001}, {0x72cb5bd86321e38c, 0x5b67334174000001},
+    {0x5bd5e313828182d6, 0x7c528f6790000001}, {0x4977e8dc68679bdf, 0x16a872b940000001},
+    {0x758ca7c70d7292fe, 0x5773eac200000001}, {0x5e0a1fd271287598, 0x45f6556800000001},
+    {0x4b3b4ca85a86c47a, 0x04c5112000000001}, {0x785ee10d5da46d90, 0x07a1b50000000001},
+    {0x604be73de4838ad9, 0x52e7c40000000001}, {0x4d0985cb1d3608ae, 0x0f1fd00000000001},
+    {0x7b426fab61f00de3, 0x31cc800000000001}, {0x629b8c891b267182, 0x5b0a000000000001},
+    {0x4ee2d6d415b85ace, 0x7c08000000000001}, {0x7e37be2022c0914b, 0x1340000000000001},
+    {0x64f964e68233a76f, 0x2900000000000001}, {0x50c783eb9b5c85f2, 0x5400000000000001},
+    {0x409f9cbc7c4a04c2, 0x1000000000000001}, {0x6765c793fa10079d, 0x0000000000000001},
+    {0x52b7d2dcc80cd2e4, 0x0000000000000001}, {0x422ca8b0a00a4250, 0x0000000000000001},
+    {0x69e10de76676d080, 0x0000000000000001}, {0x54b40b1f852bda00, 0x0000000000000001},
+    {0x43c33c1937564800, 0x0000000000000001}, {0x6c6b935b8bbd4000, 0x0000000000000001},
+    {0x56bc75e2d6310000, 0x0000000000000001}, {0x4563918244f40000, 0x0000000000000001},
+    {0x6f05b59d3b200000, 0x0000000000000001}, {0x58d15e1762800000, 0x0000000000000001},
+    {0x470de4df82000000, 0x0000000000000001}, {0x71afd498d0000000, 0x0000000000000001},
+    {0x5af3107a40000000, 0x0000000000000001}, {0x48c2739500000000, 0x0000000000000001},
+    {0x746a528800000000, 0x0000000000000001}, {0x5d21dba000000000, 0x0000000000000001},
+    {0x4a817c8000000000, 0x0000000000000001}, {0x7735940000000000, 0x0000000000000001},
+    {0x5f5e100000000000, 0x0000000000000001}, {0x4c4b400000000000, 0x0000000000000001},
+    {0x7a12000000000000, 0x0000000000000001}, {0x61a8000000000000, 0x0000000000000001},
+    {0x4e20000000000000, 0x0000000000000001}, {0x7d00000000000000, 0x0000000000000001},
+    {0x6400000000000000, 0x0000000000000001}, {0x5000000000000000, 0x0000000000000001},
+    {0x4000000000000000, 0x0000000000000001}, {0x6666666666666666, 0x3333333333333334},
+    {0x51eb851eb851eb85, 0x0f5c28f5c28f5c29}, {0x4189374bc6a7ef9d, 0x5916872b020c49bb},
+    {0x68db8bac710cb295, 0x74f0d844d013a92b}, {0x53e2d6238da3c211, 0x43f3e0370cdc8755},
+    {0x431bde82d7b634da, 0x698fe69270b06c44}, {0x6b5fca6af2bd215e, 0x0f4ca41d811a46d4},
+    {0x55e63b88c230e77e, 0x3f70834acdae9f10}, {0x44b82fa09b5a52cb, 0x4c5a02a23e254c0d},
+    {0x6df37f675ef6eadf, 0x2d5cd10396a21347}, {0x57f5ff85e592557f, 0x3de3da69454e75d3},
+    {0x465e6604b7a84465, 0x7e4fe1edd10b9175}, {0x709709a125da0709, 0x4a19697c81ac1bef},
+    {0x5a126e1a84ae6c07, 0x54e1213067bce326}, {0x480ebe7b9d58566c, 0x43e74dc052fd8285},
+    {0x734aca5f6226f0ad, 0x530baf9a1e626a6d}, {0x5c3bd5191b525a24, 0x426fbfae7eb521f1},
+    {0x49c97747490eae83, 0x4ebfcc8b9890e7f4}, {0x760f253edb4ab0d2, 0x4acc7a78f41b0cba},
+    {0x5e72843249088d75, 0x223d2ec729af3d62}, {0x4b8ed0283a6d3df7, 0x34fdbf05baf29781},
+    {0x78e480405d7b9658, 0x54c931a2c4b758cf}, {0x60b6cd004ac94513, 0x5d6dc14f03c5e0a5},
+    {0x4d5f0a66a23a9da9, 0x31249aa59c9e4d51}, {0x7bcb43d769f762a8, 0x4ea0f76f60fd4882},
+    {0x63090312bb2c4eed, 0x254d92bf80caa068}, {0x4f3a68dbc8f03f24, 0x1dd7a89933d54d20},
+    {0x7ec3daf941806506, 0x62f2a75b86221500}, {0x65697bfa9acd1d9f, 0x025bb91604e810cd},
+    {0x51212ffbaf0a7e18, 0x684960de6a5340a4}, {0x40e7599625a1fe7a, 0x203ab3e521dc33b6},
+    {0x67d88f56a29cca5d, 0x19f7863b696052bd}, {0x5313a5dee87d6eb0, 0x7b2c6b62bab37564},
+    {0x42761e4bed31255a, 0x2f56bc4efbc2c450}, {0x6a5696dfe1e83bc3, 0x655793b192d13a1a},
+    {0x5512124cb4b9c969, 0x377942f475742e7b}, {0x440e750a2a2e3aba, 0x5f9435905df68b96},
+    {0x6ce3ee76a9e3912a, 0x65b9ef4d63241289}, {0x571cbec554b60dbb, 0x6afb25d782834207},
+    {0x45b0989ddd5e7163, 0x08c8eb12cecf6806}, {0x6f80f42fc8971bd1, 0x5adb11b7b14bd9a3},
+    {0x5933f68ca078e30e, 0x157c0e2c8dd647b5}, {0x475cc53d4d2d8271, 0x5dfcd823a4ab6c91},
+    {0x722e086215159d82, 0x632e269f6ddf141b}, {0x5b5806b4ddaae468, 0x4f581ee5f17f4349},
+    {0x49133890b1558386, 0x72ace584c1329c3b}, {0x74eb8db44eef38d7, 0x6aae3c079b842d2a},
+    {0x5d893e29d8bf60ac, 0x5558300616035755}, {0x4ad431bb13cc4d56, 0x7779c004de6912ab},
+    {0x77b9e92b52e07bbe, 0x258f99a163db5111}, {0x5fc7edbc424d2fcb, 0x37a614811caf740d},
+    {0x4c9ff163683dbfd5, 0x7951aa00e3bf900b}, {0x7a998238a6c932ef, 0x754f7667d2cc19ab},
+    {0x6214682d523a8f26, 0x2aa5f8530f09ae22}, {0x4e76b9bddb620c1e, 0x55519375a5a1581b},
+    {0x7d8ac2c95f034697, 0x3bb5b8bc3c3559c5}, {0x646f023ab2690545, 0x7c9160969691149e},
+    {0x5058ce955b87376b, 0x16dab3ababa743b2}, {0x40470baaaf9f5f88, 0x78aef622efb902f5},
+    {0x66d812aab29898db, 0x0de4bd04b2c19e54}, {0x524675555bad4715, 0x57ea30d08f014b76},
+    {0x41d1f7777c8a9f44, 0x4654f3da0c01092c}, {0x694ff258c7443207, 0x23bb1fc346680eac},
+    {0x543ff513d29cf4d2, 0x4fc8e635d1ecd88a}, {0x43665da9754a5d75, 0x263a51c4a7f0ad3b},
+    {0x6bd6fc425543c8bb, 0x56c3b607731aaec4}, {0x5645969b77696d62, 0x789c919f8f488bd0},
+    {0x4504787c5f878ab5, 0x46e3a7b2d906d640}, {0x6e6d8d93cc0c1122, 0x3e390c515b3e239a},
+    {0x5857a4763cd6741b, 0x4b60d6a77c31b615}, {0x46ac8391ca4529af, 0x55e7121f968e2b44},
+    {0x711405b6106ea919, 0x0971b698f0e3786d}, {0x5a766af80d255414, 0x078e2bad8d82c6bd},
+    {0x485ebbf9a41ddcdc, 0x6c71bc8ad79bd231}, {0x73cac65c39c96161, 0x2d82c7448c2c8382},
+    {0x5ca23849c7d44de7, 0x3e023903a356cf9b}, {0x4a1b603b06437185, 0x7e682d9c82abd949},
+    {0x76923391a39f1c09, 0x4a4048fa6aac8edb}, {0x5edb5c7482e5b007, 0x55003a61eef07249},
+    {0x4be2b05d35848cd2, 0x773361e7f259f507}, {0x796ab3c855a0e151, 0x3eb89ca6508fee71},
+    {0x6122296d114d810d, 0x7efa16eb73a6585b}, {0x4db4edf0daa4673e, 0x3261abef8fb846af},
+    {0x7c54afe7c43a3eca, 0x1d691318e5f3a44b}, {0x6376f31fd02e98a1, 0x64540f471e5c836f},
+    {0x4f925c1973587a1b, 0x0376729f4b7d35f3}, {0x7f50935bebc0c35e, 0x38bd84321261efeb},
+    {0x65da0f7cbc9a35e5, 0x13cad0280eb4bfef}, {0x517b3f96fd482b1d, 0x5ca240200bc3ccbf},
+    {0x412f66126439bc17, 0x63b50019a3030a33}, {0x684bd683d38f9359, 0x1f88002904d1a9ea},
+    {0x536fdecfdc72dc47, 0x32d3335403daee55}, {0x42bfe57316c249d2, 0x5bdc291003158b77},
+    {0x6acca251be03a951, 0x12f9db4cd1bc1258}, {0x557081dafe695440, 0x7594af70a7c9a847},
+    {0x445a017bfebaa9cd, 0x4476f2c0863aed06}, {0x6d5ccf2ccac442e2, 0x3a57eacda3917b3c},
+    {0x577d728a3bd03581, 0x7b7988a482dac8fd}, {0x45fdf53b630cf79b, 0x15fad3b6cf156d97},
+    {0x6ffcbb923814bf5e, 0x565e1f8ae4ef15be}, {0x5996fc74f9aa32b2, 0x11e4e608b725aaff},
+    {0x47abfd2a6154f55b, 0x27ea51a0928488cc}, {0x72acc843ceee555e, 0x7310829a84074146},
+    {0x5bbd6d030bf1dde5, 0x42739baed005cdd2}, {0x49645735a327e4b7, 0x4ec2e2f24004a4a8},
+    {0x756d5855d1d96df2, 0x4ad16b1d333aa10c}, {0x5df11377db1457f5, 0x2241227dc2954da3},
+    {0x4b2742c648dd132a, 0x4e9a81fe35443e1c}, {0x783ed13d4161b844, 0x175d9cc9eed39694},
+    {0x603240fdcde7c69c, 0x7917b0a18bdc7876}, {0x4cf500cb0b1fd217, 0x1412f3b46fe39392},
+    {0x7b219ade7832e9be, 0x535185ed7fd285b6}, {0x628148b1f9c25498, 0x42a79e57997537c5},
+    {0x4ecdd3c1949b76e0, 0x3552e512e12a9304}, {0x7e161f9c20f8be33, 0x6eeb081e3510eb39},
+    {0x64de7fb01a609829, 0x3f226ce4f740bc2e}, {0x50b1ffc0151a1354, 0x3281f0b72c33c9be},
+    {0x408e66334414dc43, 0x42018d5f568fd498}, {0x674a3d1ed354939f, 0x1ccf48988a7fba8d},
+    {0x52a1ca7f0f76dc7f, 0x30a5d3ad3b99620b}, {0x421b0865a5f8b065, 0x73b7dc8a96144e6f},
+    {0x69c4da3c3cc11a3c, 0x52bfc7442353b0b1}, {0x549d7b6363cdae96, 0x756639034f7626f4},
+    {0x43b12f82b63e2545, 0x4451c735d92b525d}, {0x6c4eb26abd303ba2, 0x3a1c71efc1deea2e},
+    {0x56a55b889759c94e, 0x61b05b2634b254f2}, {0x45511606df7b0772, 0x1af37c1e908eaa5b},
+    {0x6ee8233e325e7250, 0x2b1f2cfdb41776f8}, {0x58b9b5cb5b7ec1d9, 0x6f4c23fe29ac5f2d},
+    {0x46faf7d5e2cbce47, 0x72a34ffe87bd18f1}, {0x71918c896adfb073, 0x04387ffda5fb5b1b},
+    {0x5adad6d4557fc05c, 0x0360666484c915af}, {0x48af1243779966b0, 0x02b3851d3707448c},
+    {0x744b506bf28f0ab3, 0x1dec082ebe720746}, {0x5d090d2328726ef5, 0x64bcd358985b3905},
+    {0x4a6da41c205b8bf7, 0x6a30a913ad15c738}, {0x7715d36033c5acbf, 0x5d1aa81f7b560b8c},
+    {0x5f44a919c3048a32, 0x7daeece5fc44d609}, {0x4c36edae359d3b5b, 0x7e258a51969d7808},
+    {0x79f17c49ef61f893, 0x16a276e8f0fbf33f}, {0x618dfd07f2b4c6dc, 0x121b9253f3fcc299},
+    {0x4e0b30d328909f16, 0x41afa84329970214}, {0x7cdeb4850db431bd, 0x4f7f739ea8f19ced},
+    {0x63e55d373e29c164, 0x3f99294bba5ae3f1}, {0x4feab0f8fe87cde9, 0x7fadbaa2fb7be98d},
+    {0x7fdde7f4ca72e30f, 0x7f7c5dd1925fdc15}, {0x664b1ff7085be8d9, 0x4c637e4141e649ab},
+    {0x51d5b32c06afed7a, 0x704f983434b83aef}, {0x4177c2899ef32462, 0x26a6135cf6f9c8bf},
+    {0x68bf9da8fe51d3d0, 0x3dd685618b294132}, {0x53cc7e20cb74a973, 0x4b12044e08edcdc2},
+    {0x4309fe80a2c3bac2, 0x6f419d0b3a57d7ce}, {0x6b4330cdd1392ad1, 0x320294dec3bfbfb0},
+    {0x55cf5a3e40fa88a7, 0x419baa4bcfcc995a}, {0x44a5e1cb672ed3b9, 0x1ae2eea30ca3ade1},
+    {0x6dd636123eb152c1, 0x77d17dd1add2afcf}, {0x57de91a832277567, 0x797464a7be42263f},
+    {0x464ba7b9c1b92ab9, 0x4790508631ce84ff}, {0x70790c5c6928445c, 0x0c1a1a704fb0d4cc},
+    {0x59fa7049edb9d049, 0x567b4859d95a43d6}, {0x47fb8d07f161736e, 0x11fc39e17aae9cab},
+    {0x732c14d98235857d, 0x032d2968c44a9445}, {0x5c2343e134f79dfd, 0x4f575453d03ba9d1},
+    {0x49b5cfe75d92e4ca, 0x72ac4376402fbb0e}, {0x75efb30bc8eb07ab, 0x0446d256cd192b49},
+    {0x5e595c096d88d2ef, 0x1d0575123dadbc3a}, {0x4b7ab0078ad3dbf2, 0x4a6ac40e97be302f},
+    {0x78c44cd8de1fc650, 0x771139b0f2c9e6b1}, {0x609d0a4718196b73, 0x78da948d8f07ebc1},
+    {0x4d4a6e9f467abc5c, 0x60aedd3e0c065634}, {0x7baa4a9870c46094, 0x344afb9679a3bd20},
+    {0x62eea2138d69e6dd, 0x103bfc78614fca80}, {0x4f254e760abb1f17, 0x26966393810ca200},
+    {0x7ea21723445e9825, 0x2423d2859b476999}, {0x654e78e9037ee01d, 0x69b642047c392148},
+    {0x510b93ed9c658017, 0x6e2b680396941aa0}, {0x40d60ff149eaccdf, 0x71bc53361210154d},
+    {0x67bce64edcaae166, 0x1c6085235019bbae}, {0x52fd850be3bbe784, 0x7d1a041c40149625},
+    {0x42646a6fe9631f9d, 0x4a7b367d0010781d}, {0x6a3a43e642383295, 0x5d91f0c8001a59c8},
+    {0x54fb698501c68ede, 0x17a7f3d3334847d4}, {0x43fc546a67d20be4, 0x79532975c2a03976},
+    {0x6cc6ed770c83463b, 0x0eeb75893766c256}, {0x57058ac5a39c382f, 0x25892ad42c523512},
+    {0x459e089e1c7cf9bf, 0x37a0ef102374f742}, {0x6f6340fcfa618f98, 0x59017e8038bb2536},
+    {0x591c33fd951ad946, 0x7a67986693c8ea91}, {0x4749c33144157a9f, 0x151fad1edca0bba8},
+    {0x720f9eb539bbf765, 0x0832ae97c76792a5}, {0x5b3fb22a94965f84, 0x068ef21305ec7551},
+    {0x48ffc1bbaa11e603, 0x1ed8c1a8d189f774}, {0x74cc692c434fd66b, 0x4af4690e1c0ff253},
+    {0x5d705423690cab89, 0x225d20d816732843}, {0x4ac0434f873d5607, 0x35174d79ab8f5369},
+    {0x779a054c0b955672, 0x21bee25c45b21f0e}, {0x5fae6aa33c77785b, 0x3498b5169e2818d8},
+    {0x4c8b888296c5f9e2, 0x5d46f7454b534713}, {0x7a78da6a8ad65c9d, 0x7ba4bed545520b52},
+    {0x61fa48553bdeb07e, 0x2fb6ff110441a2a8}, {0x4e61d37763188d31, 0x72f8cc0d9d014eed},
+    {0x7d6952589e8daeb6, 0x1e5ae015c80217e1}, {0x645441e07ed7bef8, 0x1848b344a001acb4},
+    {0x504367e6cbdfcbf9, 0x603a2903b3348a2a}, {0x4035ecb8a3196ffb, 0x002e873628f6d4ee},
+    {0x66bcadf43828b32b, 0x19e40b89db2487e3}, {0x52308b29c686f5bc, 0x14b66fa17c1d3983},
+    {0x41c06f549ed25e30, 0x1091f2e7967dc79c}, {0x6933e554315096b3, 0x341cb7d8f0c93f5f},
+    {0x542984435aa6def5, 0x767d5fe0c0a0ff80}, {0x435469cf7bb8b25e, 0x2b977fe70080cc66},
+    {0x6bba42e592c11d63, 0x5f58cca4cd9ae0a3}, {0x562e9beadbcdb11c, 0x4c470a1d7148b3b6},
+    {0x44f216557ca48db0, 0x3d05a1b1276d5c92}, {0x6e5023bbfaa0e2b3, 0x7b3c35e83f1560e9},
+    {0x58401c96621a4ef6, 0x2f635e5365aab3ed}, {0x4699b0784e7b725e, 0x591c4b75eaeef658},
+    {0x70f5e726e3f8b6fd, 0x74fa125644b18a26}, {0x5a5e5285832d5f31, 0x43fb41de9d5ad4eb},
+    {0x484b75379c244c27, 0x4ffc34b2177bdd89}, {0x73abeebf603a1372, 0x4cc6bab68bf96274},
+    {0x5c898bcc4cfb42c2, 0x0a38955ed6611b90}, {0x4a07a309d72f689b, 0x21c6dde5784dafa7},
+    {0x76729e762518a75e, 0x693e2fd58d49190b}, {0x5ec2185e8413b918, 0x5431bfde0aa0e0d5},
+    {0x4bce79e536762dad, 0x29c1664b3bb3e711}, {0x794a5ca1f0bd15e2, 0x0f9bd6dec5eca4e8},
+    {0x61084a1b26fdab1b, 0x2616457f04bd50ba}, {0x4da03b48ebfe227c, 0x1e783798d09773c8},
+    {0x7c33920e46636a60, 0x30c058f480f252d9}, {0x635c74d8384f884d, 0x0d66ad9067284247},
+    {0x4f7d2a469372d370, 0x711ef14052869b6c}, {0x7f2eaa0a85848581, 0x34fe4ecd50d75f14},
+    {0x65beee6ed136d134, 0x2a650bd773df7f43}, {0x51658b8bda9240f6, 0x551da312c319329c},
+    {0x411e093caedb672b, 0x5db14f4235adc217}, {0x68300ec77e2bd845, 0x7c4ee536bc49368a},
+    {0x5359a56c64efe037, 0x7d0bea92303a9208}, {0x42ae1df050bfe693, 0x173cbba8269541a0},
+    {0x6ab02fe6e79970eb, 0x3ec792a6a422029a}, {0x5559bfebec7ac0bc, 0x3239421ee9b4cee1},
+    {0x4447ccbcbd2f0096, 0x5b6101b25490a581}, {0x6d3fadfac84b3424, 0x2bce691d541aa268},
+    {0x576624c8a03c29b6, 0x563eba7ddce21b87}, {0x45eb50a08030215e, 0x78322ecb171b4939},
+    {0x6fdee76733803564, 0x59e9e47824f87527}, {0x597f1f85c2ccf783, 0x6187e9f9b72d2a86},
+    {0x4798e6049bd72c69, 0x346cbb2e2c242205}, {0x728e3cd42c8b7a42, 0x20adf849e039d007},
+    {0x5ba4fd768a092e9b, 0x33be603b19c7d99f}, {0x4950cac53b3a8baf, 0x42feb3627b0647b3},
+    {0x754e113b91f745e5, 0x5197856a5e7072b8}, {0x5dd80dc941929e51, 0x27ac6abb7ec05bc6},
+    {0x4b133e3a9adbb1da, 0x52f05562cbcd1638}, {0x781ec9f75e2c4fc4, 0x1e4d556adfae89f3},
+    {0x6018a192b1bd0c9c, 0x7ea444557fbed4c3}, {0x4ce0814227ca707d, 0x4bb69d1132ff109c},
+    {0x7b00ced03faa4d95, 0x5f8a94e851981a93}, {0x62670bd9cc883e11, 0x32d543ed0e134875},
+    {0x4eb8d647d6d364da, 0x5bddcff0d80f6d2b}, {0x7df48a0c8aebd491, 0x12fc7fe7c018aeab},
+    {0x64c3a1a3a25643a7, 0x28c9ffec99ad5889}, {0x509c814fb511cfb9, 0x0707fff07af113a1},
+    {0x407d343fc40e3fc7, 0x1f39998d2f2742e7}, {0x672eb9ffa016cc71, 0x7ec28f484b7204a4},
+    {0x528bc7ffb345705b, 0x189ba5d36f8e6a1d}, {0x42096ccc8f6ac048, 0x7a161e42bfa521b1},
+    {0x69a8ae1418aacd41, 0x435696d132a1cf81}, {0x5486f1a9ad557101, 0x1c454574288172ce},
+    {0x439f27baf1112734, 0x169dd129ba0128a5}, {0x6c31d92b1b4ea520, 0x242fb50f9001daa1},
+    {0x568e4755af721db3, 0x368c90d940017bb4}, {0x453e9f77bf8e7e29, 0x120a0d7a999ac95d},
+    {0x6eca98bf98e3fd0e, 0x50101590f5c47561}, {0x58a213cc7a4ffda5, 0x26734473f7d05de8},
+    {0x46e80fd6c83ffe1d, 0x6b8f69f65fd9e4b9}, {0x71734c8ad9fffcfc, 0x45b24323cc8fd45c},
+    {0x5ac2a3a247fffd96, 0x6af502830a0ca9e3}, {0x489bb61b6ccccadf, 0x08c402026e7087e9},
+    {0x742c569247ae1164, 0x746cd003e3e73fdb}, {0x5cf04541d2f1a783, 0x76bd73364fec3315},
+    {0x4a59d101758e1f9c, 0x5efdf5c50cbcf5ab}, {0x76f61b3588e365c7, 0x4b2fefa1adfb22ab},
+    {0x5f2b48f7a0b5eb06, 0x08f3261af195b555}, {0x4c22a0c61a2b226b, 0x20c284e25ade2aab},
+    {0x79d1013cf6ab6a45, 0x1ad0d49d5e304444}, {0x617400fd9222bb6a, 0x48a7107de4f369d0},
+    {0x4df6673141b562bb, 0x53b8d9fe50c2bb0d}, {0x7cbd71e869223792, 0x52c15cca1ad12b48},
+    {0x63cac186ba81c60e, 0x75677d6e7bda8906}, {0x4fd5679efb9b04d8, 0x5dec645863153a6c},
+    {0x7fbbd8fe5f5e6e27, 0x497a3a2704eec3df},
+};
+
+// floor(log10(2^q))
+static int flog10_pow2(int q) {
+    return (int)(((int64_t)q * 661971961083LL) >> 41);
+}
+
+// floor(log10(3/4 * 2^q))
+static int flog10_three_quarters_pow2(int q) {
+    return (int)(((int64_t)q * 661971961083LL - 274743187321LL) >> 41);
+}
+
+// floor(log2(10^e))
+static int flog2_pow10(int e) {
+    return (int)(((int64_t)e * 913124641741LL) >> 38);
+}
+
+static uint64_t mul_high64(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    return (uint64_t)(((unsigned __int128)a * b) >> 64);
+#else
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t mid = (a1 * b0) + ((a0 * b0) >> 32);
+    return (a1 * b1) + (mid >> 32) + (((uint32_t)mid + (a0 * b1)) >> 32);
+#endif
+}
+
+// floor(g * cp / 2^127), with the lowest bit set if the division isn't exact
+static uint64_t round_to_odd(const uint64_t* g, uint64_t cp) {
+    uint64_t x1 = mul_high64(g[1], cp);
+    uint64_t y0 = g[0] * cp;
+    uint64_t y1 = mul_high64(g[0], cp);
+    uint64_t z = (y0 >> 1) + x1;
+    uint64_t vbp = y1 + (z >> 63);
+    return vbp | (((z & 0x7fffffffffffffffULL) + 0x7fffffffffffffffULL) >> 63);
+}
+
+// sets f and e so that f * 10^e is the shortest decimal (the closest one if there are more) that rounds back to c * 2^q,
+// c_min and q_min are the smallest normal significand and the subnormal exponent of the binary format
+static void schubfach(uint64_t c, int q, uint64_t c_min, int q_min, uint64_t* f, int* e) {
+    uint64_t out = c & 1, cb = c << 2, cbr = cb + 2, cbl;
+    int k;
+    if (c != c_min || q == q_min) {
+        cbl = cb - 2;
+        k = flog10_pow2(q);
+    } else {
+        cbl = cb - 1;
+        k = flog10_three_quarters_pow2(q);
+    }
+    int h = q + flog2_pow10(-k) + 2;
+    const uint64_t* g = schubfach_g[k - SCHUBFACH_K_MIN];
+    uint64_t vb = round_to_odd(g, cb << h), vbl = round_to_odd(g, cbl << h), vbr = round_to_odd(g, cbr << h);
+    uint64_t s = vb >> 2;
+    if (s >= 100) {
+        // one digit less is enough if exactly one of its two neighbours is in the interval
+        uint64_t sp10 = (s / 10) * 10, tp10 = sp10 + 10;
+        int upin = vbl + out <= sp10 << 2, wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin) {
+            *f = upin ? sp10 : tp10;
+            *e = k;
+            return;
+        }
+    }
+    uint64_t t = s + 1;
+    int uin = vbl + out <= s << 2, win = (t << 2) + out <= vbr;
+    *e = k;
+    if (uin != win) {
+        *f = uin ? s : t;
+        return;
+    }
+    // both in: the closest one, ties to even
+    int64_t cmp = (int64_t)(vb - ((s + t) << 1));
+    *f = cmp < 0 || (cmp == 0 && (s & 1) == 0) ? s : t;
+}
+
+// writes f * 10^e like printf's %.{prec}g would, with prec the number of digits of f but at least min_prec
+static char* format_decimal(char* p, uint64_t f, int e, int min_prec) {
+    char digits[20];
+    while (f % 10 == 0) {
+        f /= 10;
+        e++;
+    }
+    int n = (int)(format_u64(digits, f) - digits), x = e + n - 1;
+    if (x < -4 || x >= (n > min_prec ? n : min_prec)) {
+        *p++ = digits[0];
+        if (n > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, (usize)(n - 1));
+            p += n - 1;
+        }
+        *p++ = 'e';
+        *p++ = x < 0 ? '-' : '+';
+        if (x < 0)
+            x = -x;
+        if (x < 10)
+            *p++ = '0';
+        return format_u64(p, (uint64_t)x);
+    }
+    if (x < 0) {
+        memcpy(p, "0.0000", (usize)(1 - x));
+        p += 1 - x;
+        memcpy(p, digits, (usize)n);
+        return p + n;
+    }
+    if (n <= x + 1) {
+        memcpy(p, digits, (usize)n);
+        memset(p + n, '0', (usize)(x + 1 - n));
+        return p + x + 1;
+    }
+    memcpy(p, digits, (usize)(x + 1));
+    p[x + 1] = '.';
+    memcpy(p + x + 2, digits + x + 1, (usize)(n - x - 1));
+    return p + n + 1;
+}
+
+// shortest text that reads back as the same value, formatted as %g would with at least 6 (float) or 15 (double) digits
+static char* format_real(char* p, double val, int is_float) {
+    if (isnan(val)) {
+        memcpy(p, "nan", 3);
+        return p + 3;
+    }
+    if (signbit(val))
+        *p++ = '-';
+    if (isinf(val)) {
+        memcpy(p, "inf", 3);
+        return p + 3;
+    }
+    val = fabs(val);
+    // integers below 10^min_prec are written in full by %g too, larger ones get an exponent from format_decimal()
+    if (val < (is_float ? 1e6 : 1e15) && val == (double)(int64_t)val)
+        return format_u64(p, (uint64_t)val);
+    uint64_t f, c;
+    int e, q;
+    if (is_float) {
+        float x = (float)val;
+        uint32_t bits;
+        memcpy(&bits, &x, 4);
+        int bq = (int)(bits >> 23);
+        c = bits & 0x7fffff;
+        q = bq != 0 ? bq - 150 : -149;
+        if (bq != 0)
+            c |= (uint64_t)1 << 23;
+        schubfach(c, q, (uint64_t)1 << 23, -149, &f, &e);
+        return format_decimal(p, f, e, 6);
+    }
+    uint64_t bits;
+    memcpy(&bits, &val, 8);
+    int bq = (int)(bits >> 52);
+    c = bits & 0xfffffffffffffULL;
+    q = bq != 0 ? bq - 1075 : -1074;
+    if (bq != 0)
+        c |= (uint64_t)1 << 52;
+    schubfach(c, q, (uint64_t)1 << 52, -1074, &f, &e);
+    return format_decimal(p, f, e, 15);
+}
+
+static usize write_text(Vector* v, ArrayUtilsValueType type, char delim, TextSink* sink) {
+    if (v->objsize != value_type_size(type)) {
+        handle_err(ObjectSizeMismatchError, "Vector objsize doesn't match the requested value type");
+        return 0;
+    }
+    sink->buf = safe_alloc(TEXT_CHUNK);
+    const uchar* data = v->data;
+    for (usize i = 0; i < v->size && !sink->failed; i++, data += v->objsize) {
+        if (TEXT_CHUNK - sink->len < 64)
+            sink_flush(sink);
+        char* p = sink->buf + sink->len;
+        switch (type) {
+            case ValueInt8: {int8_t x; memcpy(&x, data, 1); p = format_i64(p, x); break;}
+            case ValueInt16: {int16_t x; memcpy(&x, data, 2); p = format_i64(p, x); break;}
+            case ValueInt32: {int32_t x; memcpy(&x, data, 4); p = format_i64(p, x); break;}
+            case ValueInt64: {int64_t x; memcpy(&x, data, 8); p = format_i64(p, x); break;}
+            case ValueUInt8: {uint8_t x; memcpy(&x, data, 1); p = format_u64(p, x); break;}
+            case ValueUInt16: {uint16_t x; memcpy(&x, data, 2); p = format_u64(p, x); break;}
+            case ValueUInt32: {uint32_t x; memcpy(&x, data, 4); p = format_u64(p, x); break;}
+            case ValueUInt64: {uint64_t x; memcpy(&x, data, 8); p = format_u64(p, x); break;}
+            case ValueFloat: {float x; memcpy(&x, data, 4); p = format_real(p, x, 1); break;}
+            case ValueDouble: {double x; memcpy(&x, data, 8); p = format_real(p, x, 0); break;}
+        }
+        *p++ = i + 1 < v->size ? delim : '\n';
+        sink->len = (usize)(p - sink->buf);
+    }
+    sink_flush(sink);
+    free(sink->buf);
+    return sink->written;
+}
+
+usize vector_write_text(Vector* v, ArrayUtilsValueType type, char delim, FILE* f) {
+    TextSink sink = {f, -1, NULL, 0, 0, 0};
+    return write_text(v, type, delim, &sink);
+}
+
+// source of the text readers, either a FILE* or (if f is NULL) a file descriptor
+typedef struct TextSource {
+    FILE* f;
+    int fd;
+} TextSource;
+
+// returns how many bytes were read, 0 on EOF or error (in which case IOError is raised)
+static usize source_read(TextSource* src, char* buf, usize n) {
+    if (src->f != NULL) {
+        usize got = fread(buf, 1, n, src->f);
+        if (got == 0 && ferror(src->f))
+            handle_err(IOError, "Error while reading vector as text");
+        return got;
+    }
+#ifdef ARRAYUTILS_POSIX
+    for (;;) {
+        ssize_t got = read(src->fd, buf, n);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got < 0) {
+            handle_err(IOError, "Error while reading vector as text");
+            return 0;
+        }
+        return (usize)got;
+    }
+#else
+    return 0;
+#endif
+}
+
+// bytes between the current position and the end of the source if it's a regular file, 0 if unknown
+static usize source_remaining(TextSource* src) {
+#ifdef ARRAYUTILS_POSIX
+    struct stat st;
+    int fd = src->f != NULL ? fileno(src->f) : src->fd;
+    if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return 0;
+    // the FILE* may have buffered past the position the caller sees, ftello accounts for that
+    off_t pos = src->f != NULL ? ftello(src->f) : lseek(fd, 0, SEEK_CUR);
+    if (pos < 0 || pos >= st.st_size)
+        return 0;
+    return (usize)(st.st_size - pos);
+#else
+    (void)src;
+    return 0;
+#endif
+}
+
+static int is_text_separator(char c, char delim) {
+    return c == delim || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// parses the NUL terminated token into the entry at dst, returns 0 if it isn't a valid number of type
+static int parse_value(const char* tok, ArrayUtilsValueType type, uchar* dst) {
+    if (type == ValueFloat || type == ValueDouble) {
+        char* end;
+        errno = 0;
+        double d = strtod(tok, &end);
+        // ERANGE is also set for subnormal results, which are fine, only overflow and underflow to zero are out of range
+        if (*end != '\0' || (errno == ERANGE && (isinf(d) || d == 0)))
+            return 0;
+        if (type == ValueFloat) {
+            float x = strtof(tok, NULL);
+            // a double in range can still overflow or underflow to zero as a float
+            if ((isinf(x) && !isinf(d)) || (x == 0 && d != 0))
+                return 0;
+            memcpy(dst, &x, 4);
+        } else {
+            memcpy(dst, &d, 8);
+        }
+        return 1;
+    }
+    const char* p = tok;
+    int neg = *p == '-';
+    if (*p == '-' || *p == '+')
+        p++;
+    if (*p == '\0')
+        return 0;
+    uint64_t mag = 0;
+    for (; *p; p++) {
+        unsigned digit = (unsigned)(*p - '0');
+        if (digit > 9 || mag > (UINT64_MAX - digit) / 10)
+            return 0;
+        mag = mag * 10 + digit;
+    }
+    int is_signed = type <= ValueInt64;
+    usize bits = value_type_size(type) * 8;
+    if (is_signed) {
+        uint64_t limit = (uint64_t)1 << (bits - 1);
+        if (neg ? mag > limit : mag >= limit)
+            return 0;
+        int64_t x = neg ? (int64_t)(0 - mag) : (int64_t)mag;
+        switch (type) {
+            case ValueInt8: {int8_t y = (int8_t)x; memcpy(dst, &y, 1); break;}
+            case ValueInt16: {int16_t y = (int16_t)x; memcpy(dst, &y, 2); break;}
+            case ValueInt32: {int32_t y = (int32_t)x; memcpy(dst, &y, 4); break;}
+            default: memcpy(dst, &x, 8);
+        }
+    } else {
+        if ((neg && mag != 0) || (bits < 64 && mag >> bits))
+            return 0;
+        switch (type) {
+            case ValueUInt8: {uint8_t y = (uint8_t)mag; memcpy(dst, &y, 1); break;}
+            case ValueUInt16: {uint16_t y = (uint16_t)mag; memcpy(dst, &y, 2); break;}
+            case ValueUInt32: {uint32_t y = (uint32_t)mag; memcpy(dst, &y, 4); break;}
+            default: memcpy(dst, &mag, 8);
+        }
+    }
+    return 1;
+}
+
+static usize read_text(Vector* v, ArrayUtilsValueType type, char delim, TextSource* src) {
+    if (v->objsize != value_type_size(type)) {
+        handle_err(ObjectSizeMismatchError, "Vector objsize doesn't match the requested value type");
+        return 0;
+    }
+    usize start = v->size, carry = 0, consumed = 0, remaining = source_remaining(src);
+    int reserved = remaining == 0;
+    char* buf = safe_alloc(TEXT_CHUNK + 1);
+    uchar value[8];
+    for (;;) {
+        usize got = source_read(src, buf + carry, TEXT_CHUNK - carry);
+        usize len = carry + got, end = len;
+        int eof = got == 0;
+        if (!eof) {
+            while (end > 0 && !is_text_separator(buf[end - 1], delim))
+                end--;
+            if (end == 0 && len == TEXT_CHUNK) {
+                handle_err(TextParseError, "Token too long while reading vector as text");
+                break;
+            }
+        }
+        // every complete token in [0, end) is terminated in place and parsed, the last one by the NUL past the data on EOF
+        buf[len] = '\0';
+        for (usize i = 0; i < end;) {
+            while (i < end && is_text_separator(buf[i], delim))
+                i++;
+            usize tok = i;
+            while (i < end && !is_text_separator(buf[i], delim))
+                i++;
+            if (tok == i)
+                break;
+            buf[i++] = '\0';
+            if (!parse_value(buf + tok, type, value)) {
+                handle_err(TextParseError, "Malformed number while reading vector as text");
+                continue;
+            }
+            add(v, value);
+        }
+        consumed += end;
+        // after the first chunk the density of numbers per byte is known, reserve for the whole file at once
+        if (!reserved && consumed > 0) {
+            usize parsed = v->size - start;
+            double estimate = (double)parsed / (double)consumed * (double)remaining * 1.05;
+            if (estimate < (double)((usize)-1 / v->objsize))
+                vector_reserve(v, start + (usize)estimate + 16);
+            reserved = 1;
+        }
+        carry = len - end;
+        memmove(buf, buf + end, carry);
+        if (eof)
+            break;
+    }
+    free(buf);
+    return v->size - start;
+}
+
+usize vector_read_text(Vector* v, ArrayUtilsValueType type, char delim, FILE* f) {
+    TextSource src = {f, -1};
+    return read_text(v, type, delim, &src);
+}
+
+#ifdef ARRAYUTILS_POSIX
+usize vector_write_text_fd(Vector* v, ArrayUtilsValueType type, char delim, int fd) {
+    TextSink sink = {NULL, fd, NULL, 0, 0, 0};
+    return write_text(v, type, delim, &sink);
+}
+
+usize vector_read_text_fd(Vector* v, ArrayUtilsValueType type, char delim, int fd) {
+    TextSource src = {NULL, fd};
+    return read_text(v, type, delim, &src);
+}
+
+#ifdef ARRAYUTILS_IO_URING
+// minimal io_uring driven through the raw syscalls, so that liburing isn't needed
+typedef struct IoRing {
+    int fd;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    uchar* sq_map;
+    uchar* cq_map;
+    usize sq_map_len;
+    usize cq_map_len;
+    usize sqes_len;
+    unsigned to_submit;
+} IoRing;
+
+static void ring_free(IoRing* r) {
+    if (r->sqes != NULL)
+        munmap(r->sqes, r->sqes_len);
+    if (r->cq_map != NULL && r->cq_map != r->sq_map)
+        munmap(r->cq_map, r->cq_map_len);
+    if (r->sq_map != NULL)
+        munmap(r->sq_map, r->sq_map_len);
+    if (r->fd >= 0)
+        close(r->fd);
+}
+
+// returns 0 if io_uring isn't available (old kernel, seccomp...), in which case the caller falls back to readv/writev
+static int ring_init(IoRing* r, unsigned entries) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(r, 0, sizeof(*r));
+    r->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (r->fd < 0)
+        return 0;
+    r->sq_map_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cq_map_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    r->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    int single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && r->cq_map_len > r->sq_map_len)
+        r->sq_map_len = r->cq_map_len;
+    void* sq = mmap(NULL, r->sq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    void* cq = single ? sq : mmap(NULL, r->cq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_CQ_RING);
+    void* sqes = mmap(NULL, r->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+    r->sq_map = sq == MAP_FAILED ? NULL : sq;
+    r->cq_map = cq == MAP_FAILED ? NULL : cq;
+    r->sqes = sqes == MAP_FAILED ? NULL : sqes;
+    if (r->sq_map == NULL || r->cq_map == NULL || r->sqes == NULL) {
+        ring_free(r);
+        return 0;
+    }
+    r->sq_tail = (unsigned*)(r->sq_map + p.sq_off.tail);
+    r->sq_mask = (unsigned*)(r->sq_map + p.sq_off.ring_mask);
+    r->sq_array = (unsigned*)(r->sq_map + p.sq_off.array);
+    r->cq_head = (unsigned*)(r->cq_map + p.cq_off.head);
+    r->cq_tail = (unsigned*)(r->cq_map + p.cq_off.tail);
+    r->cq_mask = (unsigned*)(r->cq_map + p.cq_off.ring_mask);
+    r->cqes = (struct io_uring_cqe*)(r->cq_map + p.cq_off.cqes);
+    return 1;
+}
+
+static void ring_queue(IoRing* r, int write, int fd, struct iovec* iov, uint64_t off, uint64_t user_data) {
+    unsigned tail = *r->sq_tail;
+    unsigned idx = tail & *r->sq_mask;
+    struct io_uring_sqe* sqe = &r->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)iov;
+    sqe->len = 1;
+    sqe->off = off;
+    sqe->user_data = user_data;
+    r->sq_array[idx] = idx;
+    __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    r->to_submit++;
+}
+
+// submits the queued requests and, if wait is set, blocks until a completion is available
+static int ring_enter(IoRing* r, int wait) {
+    for (;;) {
+        long ret = syscall(__NR_io_uring_enter, r->fd, r->to_submit, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (ret >= 0) {
+            r->to_submit -= (unsigned)ret;
+            return 1;
+        }
+        if (errno != EINTR)
+            return 0;
+    }
+}
+
+static int ring_reap(IoRing* r, struct io_uring_cqe* out) {
+    for (;;) {
+        unsigned head = *r->cq_head;
+        if (head != __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE)) {
+            *out = r->cqes[head & *r->cq_mask];
+            __atomic_store_n(r->cq_head, head + 1, __ATOMIC_RELEASE);
+            return 1;
+        }
+        if (!ring_enter(r, 1))
+            return 0;
+    }
+}
+#endif
+
+#ifdef ARRAYUTILS_POSIX
+// a file descriptor plus, when possible, the io_uring used to talk to it
+typedef struct IoEngine {
+    int fd;
+    int write;
+    int seekable;
+    int use_ring;
+    int failed;
+    off_t start;
+#ifdef ARRAYUTILS_IO_URING
+    IoRing ring;
+#endif
+} IoEngine;
+
+// up to IO_DEPTH chunks transferred together, only one batch is in flight at any time
+typedef struct IoBatch {
+    struct iovec chunks[IO_DEPTH];
+    struct iovec pending[IO_DEPTH];
+    usize done[IO_DEPTH];
+    usize n;
+    uint64_t off;
+} IoBatch;
+
+static void io_engine_init(IoEngine* e, int fd, int write) {
+    struct stat st;
+    e->fd = fd;
+    e->write = write;
+    e->failed = 0;
+    e->start = lseek(fd, 0, SEEK_CUR);
+    e->seekable = e->start >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+#ifdef ARRAYUTILS_IO_URING
+    e->use_ring = ring_init(&e->ring, IO_DEPTH);
+#else
+    e->use_ring = 0;
+#endif
+}
+
+// leaves the file position after the transferred bytes, like a plain read/write would
+static void io_engine_free(IoEngine* e, usize transferred) {
+    if (e->seekable)
+        lseek(e->fd, e->start + (off_t)transferred, SEEK_SET);
+#ifdef ARRAYUTILS_IO_URING
+    if (e->use_ring)
+        ring_free(&e->ring);
+#endif
+}
+
+// transfers the not yet done part of the chunks from first on with blocking readv/writev (preadv/pwritev on files)
+static void batch_sync(IoEngine* e, IoBatch* b, usize first) {
+    while (first < b->n) {
+        struct iovec iov[IO_DEPTH];
+        usize cnt = 0, before = 0;
+        for (usize i = 0; i <= first; i++)
+            before += b->done[i];
+        for (usize i = first; i < b->n; i++, cnt++) {
+            iov[cnt].iov_base = (uchar*)b->chunks[i].iov_base + b->done[i];
+            iov[cnt].iov_len = b->chunks[i].iov_len - b->done[i];
+        }
+        ssize_t n;
+        if (e->seekable)
+            n = e->write ? pwritev(e->fd, iov, (int)cnt, (off_t)(b->off + before)) : preadv(e->fd, iov, (int)cnt, (off_t)(b->off + before));
+        else
+            n = e->write ? writev(e->fd, iov, (int)cnt) : readv(e->fd, iov, (int)cnt);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            if (n < 0) {
+                e->failed = 1;
+                handle_err(IOError, "Error while transferring vector data");
+            }
+            return;
+        }
+        for (usize left = (usize)n; left > 0 && first < b->n; first++) {
+            usize room = b->chunks[first].iov_len - b->done[first];
+            usize k = left < room ? left : room;
+            b->done[first] += k;
+            left -= k;
+            if (b->done[first] < b->chunks[first].iov_len)
+                break;
+        }
+    }
+}
+
+#ifdef ARRAYUTILS_IO_URING
+static void batch_queue_chunk(IoEngine* e, IoBatch* b, usize i, usize before) {
+    b->pending[i].iov_base = (uchar*)b->chunks[i].iov_base + b->done[i];
+    b->pending[i].iov_len = b->chunks[i].iov_len - b->done[i];
+    ring_queue(&e->ring, e->write, e->fd, &b->pending[i], e->seekable ? b->off + before + b->done[i] : (uint64_t)-1, i);
+}
+#endif
+
+// starts transferring the chunks of b, with io_uring this returns right away
+static void batch_start(IoEngine* e, IoBatch* b) {
+    for (usize i = 0; i < b->n; i++)
+        b->done[i] = 0;
+#ifdef ARRAYUTILS_IO_URING
+    // streams can't have more than one request in flight or the chunks could be filled out of order
+    if (e->use_ring && (e->seekable || b->n == 1)) {
+        usize before = 0;
+        for (usize i = 0; i < b->n; i++) {
+            batch_queue_chunk(e, b, i, before);
+            before += b->chunks[i].iov_len;
+        }
+        if (ring_enter(&e->ring, 0))
+            return;
+        e->use_ring = 0;
+        ring_free(&e->ring);
+    }
+#endif
+    // without io_uring batch_finish() reads synchronously, on files the kernel can at least read ahead until then
+#ifdef POSIX_FADV_WILLNEED
+    if (!e->write && e->seekable) {
+        usize len = 0;
+        for (usize i = 0; i < b->n; i++)
+            len += b->chunks[i].iov_len;
+        posix_fadvise(e->fd, (off_t)b->off, (off_t)len, POSIX_FADV_WILLNEED);
+    }
+#else
+    (void)e;
+#endif
+}
+
+// waits for the chunks of b and returns how many contiguous bytes from the first one were transferred
+static usize batch_finish(IoEngine* e, IoBatch* b) {
+    usize total = 0;
+#ifdef ARRAYUTILS_IO_URING
+    if (e->use_ring && (e->seekable || b->n == 1)) {
+        usize outstanding = b->n;
+        while (outstanding > 0) {
+            struct io_uring_cqe cqe;
+            if (!ring_reap(&e->ring, &cqe)) {
+                e->failed = 1;
+                handle_err(IOError, "Error while waiting for io_uring completions");
+                return 0;
+            }
+            usize i = (usize)cqe.user_data;
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                usize before = 0;
+                for (usize k = 0; k < i; k++)
+                    before += b->chunks[k].iov_len;
+                batch_queue_chunk(e, b, i, before);
+                ring_enter(&e->ring, 0);
+                continue;
+            }
+            if (cqe.res < 0) {
+                e->failed = 1;
+                outstanding--;
+                continue;
+            }
+            b->done[i] += (usize)cqe.res;
+            if (cqe.res > 0 && b->done[i] < b->chunks[i].iov_len) {
+                // short transfer, ask for the rest of the chunk
+                usize before = 0;
+                for (usize k = 0; k < i; k++)
+                    before += b->chunks[k].iov_len;
+                batch_queue_chunk(e, b, i, before);
+                ring_enter(&e->ring, 0);
+                continue;
+            }
+            outstanding--;
+        }
+        if (e->failed)
+            handle_err(IOError, "Error while transferring vector data");
+    } else
+#endif
+        batch_sync(e, b, 0);
+    for (usize i = 0; i < b->n; i++) {
+        total += b->done[i];
+        if (b->done[i] < b->chunks[i].iov_len)
+            break;
+    }
+    return total;
+}
+
+// size of a chunk, a whole number of objects of objsize
+static usize io_chunk_bytes(usize objsize) {
+    return objsize >= IO_CHUNK ? objsize : IO_CHUNK - (IO_CHUNK % objsize);
+}
+
+usize vector_read_fd(Vector* v, int fd) {
+    IoEngine e;
+    IoBatch b;
+    io_engine_init(&e, fd, 0);
+    usize os = v->objsize, chunk = io_chunk_bytes(os), filled = v->size * os, start = filled;
+    int depth = e.seekable ? IO_DEPTH : 1;
+    struct stat st;
+    // files are reserved once for all their remaining bytes, plus room for the batch that finds the EOF
+    if (e.seekable && fstat(fd, &st) == 0 && st.st_size > e.start)
+        vector_reserve(v, v->size + ((usize)(st.st_size - e.start) + (depth * chunk)) / os + 1);
+    b.off = e.seekable ? (uint64_t)e.start : 0;
+    for (;;) {
+        if (!ensure_capacity(v, (filled + depth * chunk) / os + 1))
+            break;
+        b.n = (usize)depth;
+        for (usize i = 0; i < b.n; i++) {
+            b.chunks[i].iov_base = v->data + filled + (i * chunk);
+            b.chunks[i].iov_len = chunk;
+        }
+        batch_start(&e, &b);
+        usize got = batch_finish(&e, &b);
+        filled += got;
+        b.off += got;
+        if (got < depth * chunk || e.failed)
+            break;
+    }
+    io_engine_free(&e, filled - start);
+    v->size = filled / os;
+    if (filled % os != 0)
+        handle_err(IOError, "Stream ended in the middle of an object");
+    return (filled - start) / os;
+}
+
+usize vector_read_fd_chunks(Vector* v, int fd, ArrayUtilsChunkCallback cb, void* ctx) {
+    IoEngine e;
+    IoBatch batches[2];
+    io_engine_init(&e, fd, 0);
+    usize os = v->objsize, chunk = io_chunk_bytes(os), total = 0;
+    usize depth = e.seekable ? IO_DEPTH : 1;
+    // the capacity of v is split in two halves, one is being filled while the caller works on the other
+    v->size = 0;
+    if (!ensure_capacity(v, (2 * depth * chunk) / os)) {
+        io_engine_free(&e, 0);
+        return 0;
+    }
+    uint64_t off = e.seekable ? (uint64_t)e.start : 0;
+    for (int h = 0; h < 2; h++) {
+        batches[h].n = depth;
+        for (usize i = 0; i < depth; i++) {
+            batches[h].chunks[i].iov_base = v->data + (((h * depth) + i) * chunk);
+            batches[h].chunks[i].iov_len = chunk;
+        }
+    }
+    int cur = 0;
+    batches[cur].off = off;
+    batch_start(&e, &batches[cur]);
+    for (;;) {
+        IoBatch* b = &batches[cur];
+        usize got = batch_finish(&e, b);
+        int eof = got < depth * chunk || e.failed;
+        if (!eof) {
+            batches[cur ^ 1].off = b->off + got;
+            batch_start(&e, &batches[cur ^ 1]);
+        }
+        if (got % os != 0) {
+            handle_err(IOError, "Stream ended in the middle of an object");
+            got -= got % os;
+        }
+        for (usize i = 0; i < depth && got > 0; i++) {
+            usize n = b->done[i] < got ? b->done[i] : got;
+            cb(b->chunks[i].iov_base, n / os, ctx);
+            got -= n;
+            total += n;
+        }
+        if (eof)
+            break;
+        cur ^= 1;
+    }
+    io_engine_free(&e, total);
+    return total / os;
+}
+
+usize vector_write_fd(Vector* v, int fd) {
+    IoEngine e;
+    IoBatch b;
+    io_engine_init(&e, fd, 1);
+    usize chunk = io_chunk_bytes(v->objsize), bytes = v->size * v->objsize, written = 0;
+    usize depth = e.seekable ? IO_DEPTH : 1;
+    b.off = e.seekable ? (uint64_t)e.start : 0;
+    while (written < bytes && !e.failed) {
+        usize planned = 0;
+        for (b.n = 0; b.n < depth && written + planned < bytes; b.n++) {
+            usize n = bytes - written - planned < chunk ? bytes - written - planned : chunk;
+            b.chunks[b.n].iov_base = v->data + written + planned;
+            b.chunks[b.n].iov_len = n;
+            planned += n;
+        }
+        batch_start(&e, &b);
+        usize put = batch_finish(&e, &b);
+        written += put;
+        b.off += put;
+        if (put < planned)
+            break;
+    }
+    io_engine_free(&e, written);
+    if (written < bytes && !e.failed)
+        handle_err(IOError, "Error while writing vector data");
+    return written;
+}
+#endif
+#endif
+
+static void vector_release(Vector* v) {
     free(v->data);
     free(v);
 }
+void vector_free(Vector* v) {
+    // only vectors found at their slot are released, anything else isn't owned by the list (and may already be freed)
+    if (allocatedArrays.nvectors == 0 || v->slot >= allocatedArrays.nvectors || allocatedArrays.vectors[v->slot] != v)
+        return;
+    Vector* last = allocatedArrays.vectors[--allocatedArrays.nvectors];
+    allocatedArrays.vectors[v->slot] = last;
+    last->slot = v->slot;
+    vector_release(v);
+}
 void free_all_arrayutils_structures() {
-    for (int i = 0; i < allocatedArrays.nvectors; i++)
-        vector_free(allocatedArrays.vectors[i]);
+    for (usize i = 0; i < allocatedArrays.nvectors; i++)
+        vector_release(allocatedArrays.vectors[i]);
     free(allocatedArrays.vectors);
+    allocatedArrays.vectors = NULL;
+    allocatedArrays.nvectors = 0;
+    allocatedArrays.generation++;
 }
 
 AllocatedArrays* expose_internal_arrays() {
@@ -356,7 +2702,7 @@ void set_resize_factor(unsigned int factor) {
     realloc_factor = factor;
 }
 
-void set_default_capacity(unsigned int capacity) {
+void set_default_capacity(size_t capacity) {
     std_capacity = capacity;
 }
 
@@ -364,10 +2710,18 @@ unsigned int get_resize_factor() {
     return realloc_factor;
 }
 
-unsigned int get_default_capacity() {
+size_t get_default_capacity() {
     return std_capacity;
 }
 
+void set_nontemporal_threshold(size_t bytes) {
+    nontemporal_threshold = bytes;
+}
+
+size_t get_nontemporal_threshold() {
+    return nontemporal_threshold;
+}
+
 void override_signal_exception_arrayutils(void (*func)(int)) {
     SIGNAL_USR_ArrayUtils = 1;
     void* ret = signal(SIGUSR1, func);
@@ -395,6 +2749,16 @@ const char* errcodetostr_arrayutils(ArrayUtilsErrors err) {
             return "EmptyPopError";
         case SignalHandlerError:
             return "SignalHandlerError";
+        case SizeOverflowError:
+            return "SizeOverflowError";
+        case ObjectSizeMismatchError:
+            return "ObjectSizeMismatchError";
+        case IOError:
+            return "IOError";
+        case TextParseError:
+            return "TextParseError";
+        case CorruptDataError:
+            return "CorruptDataError";
         default:
             return "InvalidErrorCode";
     }
@@ -402,11 +2766,26 @@ const char* errcodetostr_arrayutils(ArrayUtilsErrors err) {
 
 #undef uint
 #undef ulong
+#undef usize
 #undef uchar
 #undef ll
 #undef STD_CAPACITY
 #undef REALLOC_FACTOR
+#undef NONTEMPORAL_THRESHOLD
+#undef PREFETCH_DISTANCE
+#undef FILL_BLOCK
+#undef GALLOP_RATIO
+#undef HEAP_ARITY
+#undef TEXT_CHUNK
+#undef PIPELINE_BLOCK
+#undef IO_CHUNK
+#undef IO_DEPTH
+#undef PACKED_BLOCK
+#undef PACKED_MAGIC
+#undef SCHUBFACH_K_MIN
+#undef PREFETCH
 #undef ASSERT_MIN_SIZE_CAPACITY
+#undef ASSERT_VALID_RANGE
 #ifdef SIGUSR1ISSIGTERM
 #undef SIGUSR1
 #endif
\ No newline at end of file
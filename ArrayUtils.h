@@ -16,6 +16,16 @@
 #include <string.h>
 #include <signal.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ARRAYUTILS_POSIX
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /**
  * @brief All the errors defined in the library
@@ -27,8 +37,60 @@ typedef enum ArrayUtilsErrors {
     ReplaceMoreThanCurrentSizeError,
     EmptyPopError,
     SignalHandlerError,
+    SizeOverflowError,
+    ObjectSizeMismatchError,
+    IOError,
+    TextParseError,
+    CorruptDataError,
 } ArrayUtilsErrors;
 
+/**
+ * @brief Index value used to signal "no occurrence" by the matching functions (e.g. any_match())
+ */
+#define ARRAYUTILS_NPOS ((size_t)-1)
+
+/**
+ * @brief Comparator used by the ordered algorithms of this library, same contract as the one taken by qsort()
+ * <br> Must return a negative value if a < b, 0 if a == b, a positive value if a > b
+ */
+typedef int (*ArrayUtilsComparator)(const void* a, const void* b);
+
+/**
+ * @brief Pipeline stage that transforms the object at in into the object at out, ctx is the pointer given when adding the stage
+ * @see pipeline_map()
+ */
+typedef void (*ArrayUtilsMapper)(const void* in, void* out, void* ctx);
+
+/**
+ * @brief Pipeline stage that returns non zero for the objects to keep, ctx is the pointer given when adding the stage
+ * @see pipeline_filter()
+ */
+typedef int (*ArrayUtilsPredicate)(const void* obj, void* ctx);
+
+/**
+ * @brief Folds obj into the accumulator at acc, ctx is the pointer given to pipeline_reduce()
+ * @see pipeline_reduce()
+ */
+typedef void (*ArrayUtilsReducer)(void* acc, const void* obj, void* ctx);
+
+/**
+ * @brief Numeric types the text import/export functions know how to format and parse
+ * @see vector_write_text()
+ * @see vector_read_text()
+ */
+typedef enum ArrayUtilsValueType {
+    ValueInt8,
+    ValueInt16,
+    ValueInt32,
+    ValueInt64,
+    ValueUInt8,
+    ValueUInt16,
+    ValueUInt32,
+    ValueUInt64,
+    ValueFloat,
+    ValueDouble,
+} ArrayUtilsValueType;
+
 /**
  * @brief The types of tracing available in this library
  * <br> NoTrace is completely silent execution
@@ -91,12 +153,14 @@ typedef struct Vector Vector;
  * @param vectors
  * @param nvectors
  * @param capacity
+ * @param generation -> how many times free_all_arrayutils_structures() was called, vectors created before the last call are gone
  * @see expose_interal_arrays()
  */
 typedef struct AllocatedArrays {
     Vector** vectors;
-    unsigned int nvectors;
-    unsigned int capacity;
+    size_t nvectors;
+    size_t capacity;
+    size_t generation;
 } AllocatedArrays;
 
 /**
@@ -105,7 +169,7 @@ typedef struct AllocatedArrays {
  * @param objsize -> size of entry
  * @return pointer to created struct
  */
-Vector* vector_new(unsigned int objsize);
+Vector* vector_new(size_t objsize);
 
 /**
  * @brief Creates a vector with capacity specified with each entry of size objsize
@@ -114,7 +178,7 @@ Vector* vector_new(unsigned int objsize);
  * @param capacity -> initial capacity of vector
  * @return pointer to created struct
  */
-Vector* vector_fromsize(unsigned int objsize, unsigned long capacity);
+Vector* vector_fromsize(size_t objsize, size_t capacity);
 
 /**
  * @brief Creates a vector of ints (varargs version)
@@ -122,7 +186,7 @@ Vector* vector_fromsize(unsigned int objsize, unsigned long capacity);
  * @param ... the elements to insert in the vector
  * @return pointer to created struct
  */
-Vector* vector_from_args_int(int n_of_elements, ...);
+Vector* vector_from_args_int(size_t n_of_elements, ...);
 
 /**
  * @brief Returns the internal data buffer of given array struct
@@ -136,21 +200,42 @@ unsigned char* vdata(Vector* v);
  * @param v -> vector
  * @return size
  */
-unsigned int vsize(Vector* v);
+size_t vsize(Vector* v);
 
 /**
  * @brief Returns the internal capacity (how many items can the array hold before having to expand) of given array struct
  * @param v -> vector
  * @return capacity
  */
-unsigned long vcapacity(Vector *v);
+size_t vcapacity(Vector *v);
 
 /**
  * @brief Returns the internal objsize (size of each entry) of given array struct
  * @param v -> vector
  * @return size of each entry
  */
-unsigned int vobjsize(Vector* v);
+size_t vobjsize(Vector* v);
+
+/**
+ * @brief Makes sure the vector can hold at least capacity objects without having to expand again.
+ * <br> This never shrinks the vector. Raises SizeOverflowError if capacity * objsize doesn't fit in a size_t.
+ * @param vect -> vector
+ * @param capacity -> minimum capacity wanted
+ */
+void vector_reserve(Vector* vect, size_t capacity);
+
+/**
+ * @brief Changes the size of the vector to size objects, new objects are zero filled. Doesn't shrink the capacity.
+ * @param vect -> vector
+ * @param size -> new size
+ */
+void vector_resize(Vector* vect, size_t size);
+
+/**
+ * @brief Removes all the objects from the vector, keeping its capacity
+ * @param vect -> vector
+ */
+void vector_clear(Vector* vect);
 
 /**
  * @brief Adds an element to the end of the vector
@@ -165,7 +250,7 @@ void add(Vector* vect, void* obj);
  * @param objs -> pointer to the array of objects to add
  * @param nobj -> number of objects to add
  */
-void add_range_copy(Vector* vect, void* objs, unsigned int nobj);
+void add_range_copy(Vector* vect, void* objs, size_t nobj);
 
 /**
  * @brief Adds nobj objects to the end of the vector using memmove.
@@ -173,7 +258,7 @@ void add_range_copy(Vector* vect, void* objs, unsigned int nobj);
  * @param objs -> pointer to the array of objects to add
  * @param nobj -> number of objects to add
  */
-void add_range_move(Vector* vect, void* objs, unsigned int nobj);
+void add_range_move(Vector* vect, void* objs, size_t nobj);
 
 /**
  * @brief Adds nobj objects starting from specified index of the vector using memcpy.
@@ -182,7 +267,7 @@ void add_range_move(Vector* vect, void* objs, unsigned int nobj);
  * @param nobj -> number of objects to add
  * @param at -> index to start inserting at
  */
-void add_range_copy_at(Vector* vect, void* objs, unsigned int nobj, unsigned int at);
+void add_range_copy_at(Vector* vect, void* objs, size_t nobj, size_t at);
 
 /**
  * @brief Adds nobj objects starting from specified index of the vector using memmove.
@@ -191,7 +276,7 @@ void add_range_copy_at(Vector* vect, void* objs, unsigned int nobj, unsigned int
  * @param nobj -> number of objects to add
  * @param at -> index to start inserting at
  */
-void add_range_move_at(Vector* vect, void* objs, unsigned int nobj, unsigned int at);
+void add_range_move_at(Vector* vect, void* objs, size_t nobj, size_t at);
 
 /**
  * @brief Replaces nobj objects starting from specified index of the vector using memcpy.
@@ -200,7 +285,7 @@ void add_range_move_at(Vector* vect, void* objs, unsigned int nobj, unsigned int
  * @param nobj -> number of objects to add
  * @param at -> index to start inserting at
  */
-void replace_range_copy(Vector* vect, void* objs, unsigned int nobj, unsigned int at);
+void replace_range_copy(Vector* vect, void* objs, size_t nobj, size_t at);
 
 /**
  * @brief Replaces nobj objects starting from specified index of the vector using memmove.
@@ -209,15 +294,26 @@ void replace_range_copy(Vector* vect, void* objs, unsigned int nobj, unsigned in
  * @param nobj -> number of objects to add
  * @param at -> index to start inserting at
  */
-void replace_range_move(Vector* vect, void* objs, unsigned int nobj, unsigned int at);
+void replace_range_move(Vector* vect, void* objs, size_t nobj, size_t at);
 
+#ifndef __cplusplus                 // clashes with POSIX access() from unistd.h, which C++ compilers pull in through signal.h
 /**
  * @brief Returns pointer to i-th object of vector
  * @param v -> vector
  * @param i -> index to access
  * @return pointer to data
+ * @see vector_at()
+ */
+void* access(Vector* v, size_t i);
+#endif
+
+/**
+ * @brief Same as access(), under a name that doesn't clash with POSIX access()
+ * @param v -> vector
+ * @param i -> index to access
+ * @return pointer to data
  */
-void* access(Vector* v, unsigned int i);
+void* vector_at(Vector* v, size_t i);
 
 /**
  * @brief Returns a pointer to a COPY of i-th object of vector
@@ -225,7 +321,7 @@ void* access(Vector* v, unsigned int i);
  * @param i -> index to access
  * @return pointer to copy
  */
-void* copy_access(Vector* v, unsigned int i);
+void* copy_access(Vector* v, size_t i);
 
 /**
  * @brief Removes last item from vector and returns a copy
@@ -240,20 +336,22 @@ void* pop(Vector* vect);
  */
 void pop_noret(Vector* vect);
 
+#ifndef __cplusplus                 // delete is a keyword in C++, use delete_noret() or the wrapper in ArrayUtils.hpp from there
 /**
  * @brief Removes item at index and returns a copy
  * @param vect -> vector
  * @param index -> index to remove from
  * @return pointer to copy of removed object
  */
-void* delete(Vector* vect, unsigned int index);
+void* delete(Vector* vect, size_t index);
+#endif
 
 /**
  * @brief Removes item at index
  * @param vect -> vector
  * @param index -> index to remove from
  */
-void delete_noret(Vector* vect, unsigned int index);
+void delete_noret(Vector* vect, size_t index);
 
 /**
  * @brief Deletes first occurrence of item of value == obj
@@ -269,7 +367,7 @@ void delete_value(Vector* vect, void* obj);
  * @param n -> number of occurrences to delete
  * @return number of deleted occurrences
  */
-int delete_n_values(Vector* vect, void* obj, int n);
+size_t delete_n_values(Vector* vect, void* obj, size_t n);
 
 /**
  * @brief Deletes all occurrences of item of value == obj from vector
@@ -277,21 +375,23 @@ int delete_n_values(Vector* vect, void* obj, int n);
  * @param obj -> obj to delete
  * @return number of deleted occurrences
  */
-int delete_values(Vector* vect, void* obj);
+size_t delete_values(Vector* vect, void* obj);
 
 /**
- * @brief Frees entire vector structure
+ * @brief Frees entire vector structure and removes it from the list of allocated vectors
+ * <br> v must still be allocated: freeing it twice, or after free_all_arrayutils_structures() released it, is undefined behaviour.
  * @param v -> vector to free
  */
 void vector_free(Vector* v);
 
 /**
  * @brief Fills pre-allocated vector (resizes if needed) with nobj objects of val.
+ * <br> The pattern is written by doubling copies, so this is much faster than adding each object.
  * @param vect -> vector to fill
  * @param val -> value of obj to insert
  * @param nobj -> how many objs to insert
  */
-void fill(Vector* vect, void* val, unsigned int nobj);
+void fill(Vector* vect, void* val, size_t nobj);
 
 /**
  * @brief Checks if all objs in vector from at to (at + size) have value val.
@@ -302,7 +402,7 @@ void fill(Vector* vect, void* val, unsigned int nobj);
  * @param size -> how many objects to check
  * @return 1 if true, 0 if false
  */
-int n_matches_from_index(Vector* vect, void* val, int at, unsigned long size);
+int n_matches_from_index(Vector* vect, void* val, size_t at, size_t size);
 
 /**
  * @brief Checks if all objs in vector from 0 to vector->size have value val.
@@ -321,10 +421,10 @@ int all_match(Vector* vect, void* val);
  * @param val -> val to compare each entry to
  * @param at -> where to start
  * @param size -> how many objects to check
- * @param n -> pointer to int to fill with index of occurrence
+ * @param n -> pointer to size_t to fill with index of occurrence (ARRAYUTILS_NPOS if none)
  * @return 1 if true, 0 if false
  */
-int any_match_from_index(Vector* vect, void* val, int at, unsigned long size, int* n);
+int any_match_from_index(Vector* vect, void* val, size_t at, size_t size, size_t* n);
 
 /**
  * @brief Checks if at least one obj in vector from 0 to vector->size has value val.
@@ -332,10 +432,10 @@ int any_match_from_index(Vector* vect, void* val, int at, unsigned long size, in
  * <br> This function compares MEMORY, so be aware of potential issues.
  * @param vect -> vector to check
  * @param val -> val to compare each entry to
- * @param n -> pointer to int to fill with index of occurrence
+ * @param n -> pointer to size_t to fill with index of occurrence (ARRAYUTILS_NPOS if none)
  * @return 1 if true, 0 if false
  */
-int any_match(Vector* vect, void* val, int* n);
+int any_match(Vector* vect, void* val, size_t* n);
 
 /**
  * @brief Returns how many objs have value val from at to (at + size) in vector.
@@ -346,7 +446,7 @@ int any_match(Vector* vect, void* val, int* n);
  * @param size -> how many objs to check
  * @return times val occurred in vect from at to (at + size)
  */
-int count_match_from_index(Vector* vect, void* val, int at, unsigned long size);
+size_t count_match_from_index(Vector* vect, void* val, size_t at, size_t size);
 
 /**
  * @brief Returns how many objs have value val from 0 to vect->size in vector.
@@ -355,7 +455,7 @@ int count_match_from_index(Vector* vect, void* val, int at, unsigned long size);
  * @param val -> val to compare each entry to
  * @return how many times val has occurred in vect
  */
-int count_matches(Vector* vect, void* val);
+size_t count_matches(Vector* vect, void* val);
 
 /**
  * @brief Reverses entries of a vector in place.
@@ -371,15 +471,417 @@ void reverse(Vector* vect);
  */
 void* extract_match(Vector* vect, void* val);
 
+/**
+ * @brief Ready made comparators for signed and unsigned 4 and 8 byte integers.
+ * <br> The set operations (vector_set_intersection(), vector_set_difference()) recognize these and use SIMD when available,
+ * <br> so prefer them over a hand written equivalent.
+ */
+int cmp_int32_arrayutils(const void* a, const void* b);
+int cmp_uint32_arrayutils(const void* a, const void* b);
+int cmp_int64_arrayutils(const void* a, const void* b);
+int cmp_uint64_arrayutils(const void* a, const void* b);
+
+/**
+ * @brief Merges sorted vectors a and b into dest, which is cleared and reserved up front. Equal objects of a come before those of b.
+ * <br> dest must be a different vector than a and b and all three must have the same objsize.
+ * @param dest -> destination vector
+ * @param a -> first sorted vector
+ * @param b -> second sorted vector
+ * @param cmp -> comparator a and b are sorted by
+ */
+void vector_merge(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp);
+
+/**
+ * @brief Writes to dest the objects that are in a, in b or in both, each common object appears once.
+ * <br> a and b must be sorted and without duplicates (see vector_unique()), dest is cleared and reserved up front.
+ * <br> When one input is much smaller than the other the bigger one is skipped through with a galloping search.
+ * @param dest -> destination vector
+ * @param a -> first sorted vector
+ * @param b -> second sorted vector
+ * @param cmp -> comparator a and b are sorted by
+ * @see vector_merge()
+ */
+void vector_set_union(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp);
+
+/**
+ * @brief Writes to dest the objects that are both in a and b.
+ * <br> a and b must be sorted and without duplicates (see vector_unique()), dest is cleared and reserved up front.
+ * @param dest -> destination vector
+ * @param a -> first sorted vector
+ * @param b -> second sorted vector
+ * @param cmp -> comparator a and b are sorted by
+ * @see vector_set_union()
+ */
+void vector_set_intersection(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp);
+
+/**
+ * @brief Writes to dest the objects of a that are not in b.
+ * <br> a and b must be sorted and without duplicates (see vector_unique()), dest is cleared and reserved up front.
+ * @param dest -> destination vector
+ * @param a -> first sorted vector
+ * @param b -> second sorted vector
+ * @param cmp -> comparator a and b are sorted by
+ * @see vector_set_union()
+ */
+void vector_set_difference(Vector* dest, Vector* a, Vector* b, ArrayUtilsComparator cmp);
+
+/**
+ * @brief Removes in place every object that compares equal to the one before it, on a sorted vector this leaves only distinct objects.
+ * @param vect -> vector
+ * @param cmp -> comparator
+ * @return number of removed objects
+ */
+size_t vector_unique(Vector* vect, ArrayUtilsComparator cmp);
+
+/**
+ * @brief Binary (or d-ary) heap stored in a Vector, the top is always the smallest object according to cmp.
+ * <br> For a max heap just invert the comparator. The struct is meant to be passed around by value,
+ * <br> its storage is a normal vector so it is freed by free_all_arrayutils_structures() like every other.
+ * @param vect -> storage of the heap, objects are in heap order
+ * @param cmp -> comparator
+ * @param arity -> number of children of each node
+ * @see heap_new()
+ * @see heapify()
+ */
+typedef struct Heap {
+    Vector* vect;
+    ArrayUtilsComparator cmp;
+    unsigned int arity;
+} Heap;
+
+/**
+ * @brief Creates an empty heap with each entry of size objsize
+ * <br> Example: Heap h = heap_new(sizeof(int), cmp_int32_arrayutils, 4);
+ * @param objsize -> size of entry
+ * @param cmp -> comparator, the smallest object is on top
+ * @param arity -> children per node, 0 uses the default of 4 which keeps all the children of a node in one cache line for small objects
+ * @return created heap
+ */
+Heap heap_new(size_t objsize, ArrayUtilsComparator cmp, unsigned int arity);
+
+/**
+ * @brief Turns an existing vector into a heap in place in O(n), the vector now belongs to the heap and shouldn't be modified directly.
+ * @param vect -> vector to reorder
+ * @param cmp -> comparator, the smallest object is on top
+ * @param arity -> children per node, 0 uses the default of 4
+ * @return created heap
+ */
+Heap heapify(Vector* vect, ArrayUtilsComparator cmp, unsigned int arity);
+
+/**
+ * @brief Adds an object to the heap
+ * @param heap -> heap
+ * @param obj -> pointer to the object to add
+ */
+void heap_push(Heap* heap, void* obj);
+
+/**
+ * @brief Adds nobj objects to the heap, if the batch is big compared to the heap the whole heap is rebuilt instead of pushing one at a time.
+ * @param heap -> heap
+ * @param objs -> pointer to the array of objects to add
+ * @param nobj -> number of objects to add
+ */
+void heap_push_batch(Heap* heap, void* objs, size_t nobj);
+
+/**
+ * @brief Removes the top object of the heap copying it into out, raises EmptyPopError if the heap is empty.
+ * @param heap -> heap
+ * @param out -> where to copy the removed object, can be NULL to just discard it
+ */
+void heap_pop_into(Heap* heap, void* out);
+
+/**
+ * @brief Returns pointer to the top (smallest) object of the heap, or NULL if the heap is empty
+ * @param heap -> heap
+ * @return pointer to top object
+ */
+void* heap_top(Heap* heap);
+
+/**
+ * @brief Returns how many objects are in the heap
+ * @param heap -> heap
+ * @return size
+ */
+size_t heap_size(Heap* heap);
+
+/**
+ * @brief Frees the vector used by the heap
+ * @param heap -> heap to free
+ */
+void heap_free(Heap* heap);
+
+/**
+ * @brief Sorted map stored in two parallel vectors, one for the keys and one for the values, each with its own objsize.
+ * <br> Inserting is done in batches that are sorted and then merged with the existing entries,
+ * <br> lookups are binary searches, or after flatmap_build_index() branch free searches on an Eytzinger (BFS) copy of the keys.
+ * <br> Meant for read mostly tables: every insert invalidates the index until it's built again.
+ * @param keys -> sorted keys
+ * @param values -> values, values[i] belongs to keys[i]
+ * @param index -> keys in Eytzinger order (slot 0 unused), empty when not built or stale
+ * @param index_pos -> for each slot of index, the position of that key in keys
+ * @param cmp -> comparator for the keys
+ * @see flatmap_new()
+ */
+typedef struct FlatMap {
+    Vector* keys;
+    Vector* values;
+    Vector* index;
+    Vector* index_pos;
+    ArrayUtilsComparator cmp;
+} FlatMap;
+
+/**
+ * @brief Creates an empty map
+ * <br> Example: FlatMap m = flatmap_new(sizeof(int), sizeof(double), cmp_int32_arrayutils);
+ * @param keysize -> size of each key
+ * @param valuesize -> size of each value
+ * @param cmp -> comparator for the keys
+ * @return created map
+ */
+FlatMap flatmap_new(size_t keysize, size_t valuesize, ArrayUtilsComparator cmp);
+
+/**
+ * @brief Inserts a single entry, replacing the value if the key is already present.
+ * <br> This costs as much as moving the whole map, prefer flatmap_insert_batch() when inserting more than one entry.
+ * @param map -> map
+ * @param key -> pointer to the key
+ * @param value -> pointer to the value
+ */
+void flatmap_insert(FlatMap* map, void* key, void* value);
+
+/**
+ * @brief Inserts nobj entries, sorting them and merging them with the existing ones in a single pass.
+ * <br> If a key is repeated the last value given for it wins, both against the map and inside the batch.
+ * @param map -> map
+ * @param keys -> pointer to the array of keys
+ * @param values -> pointer to the array of values, values[i] belongs to keys[i]
+ * @param nobj -> number of entries
+ */
+void flatmap_insert_batch(FlatMap* map, void* keys, void* values, size_t nobj);
+
+/**
+ * @brief Builds the Eytzinger layout of the keys used by flatmap_find(), call this once the map is done changing.
+ * @param map -> map
+ */
+void flatmap_build_index(FlatMap* map);
+
+/**
+ * @brief Returns pointer to the value of key, or NULL if key is not in the map
+ * @param map -> map
+ * @param key -> key to look for
+ * @return pointer to value
+ */
+void* flatmap_find(FlatMap* map, const void* key);
+
+/**
+ * @brief Returns how many entries are in the map
+ * @param map -> map
+ * @return size
+ */
+size_t flatmap_size(FlatMap* map);
+
+/**
+ * @brief Frees all the vectors used by the map
+ * @param map -> map to free
+ */
+void flatmap_free(FlatMap* map);
+
+/**
+ * @brief Lazy chain of map/filter/skip/take stages over a source vector.
+ * <br> Nothing runs until a terminal operation (pipeline_collect() or pipeline_reduce()) is called,
+ * <br> then all the stages are applied together one cache sized block at a time, without any intermediate vector.
+ * <br> Example: Pipeline p = pipeline_from(v); pipeline_filter(&p, is_even, NULL); pipeline_map(&p, square, sizeof(long), NULL); pipeline_collect(&p, out);
+ * @param source -> vector the objects are read from, it's never modified
+ * @param stages -> the stages in order
+ * @param objsize -> size of the objects coming out of the last stage
+ * @see pipeline_from()
+ */
+typedef struct Pipeline {
+    Vector* source;
+    Vector* stages;
+    size_t objsize;
+} Pipeline;
+
+/**
+ * @brief Starts a pipeline over source
+ * @param source -> vector to read from
+ * @return created pipeline
+ */
+Pipeline pipeline_from(Vector* source);
+
+/**
+ * @brief Adds a stage that replaces each object with fn(object), the new objects are of size out_objsize
+ * @param p -> pipeline
+ * @param fn -> mapping function
+ * @param out_objsize -> size of the objects fn writes
+ * @param ctx -> passed as is to fn
+ */
+void pipeline_map(Pipeline* p, ArrayUtilsMapper fn, size_t out_objsize, void* ctx);
+
+/**
+ * @brief Adds a stage that only keeps the objects for which fn returns non zero
+ * @param p -> pipeline
+ * @param fn -> predicate
+ * @param ctx -> passed as is to fn
+ */
+void pipeline_filter(Pipeline* p, ArrayUtilsPredicate fn, void* ctx);
+
+/**
+ * @brief Adds a stage that drops the first n objects reaching it
+ * @param p -> pipeline
+ * @param n -> how many objects to drop
+ */
+void pipeline_skip(Pipeline* p, size_t n);
+
+/**
+ * @brief Adds a stage that lets through only the first n objects reaching it, the source stops being read once they're all out
+ * @param p -> pipeline
+ * @param n -> how many objects to keep
+ */
+void pipeline_take(Pipeline* p, size_t n);
+
+/**
+ * @brief Runs the pipeline appending its output to dest, which is reserved once for the most objects the pipeline can produce.
+ * <br> The pipeline is consumed and can't be used anymore. Raises ObjectSizeMismatchError if dest has the wrong objsize.
+ * @param p -> pipeline
+ * @param dest -> vector to append to
+ * @return number of objects appended
+ */
+size_t pipeline_collect(Pipeline* p, Vector* dest);
+
+/**
+ * @brief Runs the pipeline folding its output into acc with fn, acc should be initialized by the caller.
+ * <br> The pipeline is consumed and can't be used anymore.
+ * @param p -> pipeline
+ * @param acc -> pointer to the accumulator
+ * @param fn -> reducing function
+ * @param ctx -> passed as is to fn
+ * @return number of objects reduced
+ */
+size_t pipeline_reduce(Pipeline* p, void* acc, ArrayUtilsReducer fn, void* ctx);
+
+/**
+ * @brief Frees a pipeline that was never run, pipelines that were collected or reduced are already freed
+ * @param p -> pipeline
+ */
+void pipeline_free(Pipeline* p);
+
+/**
+ * @brief Compressed vector of 64 bit signed integers, best suited for sorted or slowly changing values (ids, timestamps...).
+ * <br> Values are packed in blocks of 128: each block stores its first value and the differences between consecutive values,
+ * <br> minus their minimum, bit packed with the fewest bits that fit them all. The last, not yet full, block is kept uncompressed.
+ * <br> Each block also keeps its min and max so searches can skip it without decoding.
+ * @param blocks -> one header per packed block
+ * @param words -> the bit packed differences of all the blocks, as 32 bit words
+ * @param tail -> uncompressed values after the last packed block
+ * @see packedint_new()
+ */
+typedef struct PackedIntVector {
+    Vector* blocks;
+    Vector* words;
+    Vector* tail;
+} PackedIntVector;
+
+/**
+ * @brief Creates an empty packed vector
+ * @return created vector
+ */
+PackedIntVector packedint_new();
+
+/**
+ * @brief Appends value, every 128 values a block gets packed
+ * @param p -> packed vector
+ * @param value -> value to append
+ */
+void packedint_add(PackedIntVector* p, int64_t value);
+
+/**
+ * @brief Appends nobj values
+ * @param p -> packed vector
+ * @param values -> pointer to the array of values
+ * @param nobj -> number of values
+ */
+void packedint_add_range(PackedIntVector* p, const int64_t* values, size_t nobj);
+
+/**
+ * @brief Returns how many values are in the packed vector
+ * @param p -> packed vector
+ * @return size
+ */
+size_t packedint_size(PackedIntVector* p);
+
+/**
+ * @brief Returns how many bytes the packed vector uses for its data
+ * @param p -> packed vector
+ * @return size in bytes
+ */
+size_t packedint_bytes(PackedIntVector* p);
+
+/**
+ * @brief Returns the i-th value, only the block containing it is decoded
+ * @param p -> packed vector
+ * @param i -> index to access
+ * @return value
+ */
+int64_t packedint_get(PackedIntVector* p, size_t i);
+
+/**
+ * @brief Decodes all the values appending them to dest, which must have objsize 8 and is reserved once
+ * @param p -> packed vector
+ * @param dest -> vector to append to
+ */
+void packedint_decode(PackedIntVector* p, Vector* dest);
+
+/**
+ * @brief Returns how many values are equal to value, blocks whose range can't contain it aren't decoded
+ * @param p -> packed vector
+ * @param value -> value to look for
+ * @return number of occurrences
+ */
+size_t packedint_count(PackedIntVector* p, int64_t value);
+
+/**
+ * @brief Checks if at least one value is equal to value, returns in n the index of the first occurrence (ARRAYUTILS_NPOS if none)
+ * @param p -> packed vector
+ * @param value -> value to look for
+ * @param n -> pointer to size_t to fill with index of occurrence
+ * @return 1 if true, 0 if false
+ */
+int packedint_any_match(PackedIntVector* p, int64_t value, size_t* n);
+
+/**
+ * @brief Appends the raw buffers of the packed vector to out (objsize 1), ready to be written somewhere (e.g. with vector_write_fd()).
+ * <br> The format is the in memory one, so it can only be read back on a machine with the same endianness.
+ * @param p -> packed vector
+ * @param out -> byte vector to append to
+ */
+void packedint_serialize(PackedIntVector* p, Vector* out);
+
+/**
+ * @brief Rebuilds a packed vector from the bytes written by packedint_serialize(), raises CorruptDataError if they aren't valid
+ * @param buf -> serialized bytes
+ * @param len -> number of bytes
+ * @return rebuilt vector
+ */
+PackedIntVector packedint_deserialize(const void* buf, size_t len);
+
+/**
+ * @brief Frees all the vectors used by the packed vector
+ * @param p -> packed vector to free
+ */
+void packedint_free(PackedIntVector* p);
+
 /**
  * @brief Prints each entry of vect with wanted format.
  * <br> This only works with non-pointer values (e.g. int, double, char...)
  * <br> To print pointer values (such as char*, int*) use print_vect_ptr()
  * <br> Example (assuming vect contains 3 ints of value 1, 2 and 3):
  * <br> print_vect(vect, "[%d] ") will print "[1] [2] [3]"
+ * <br> Only the first byte of each entry is passed to printf, to print wider numbers use vector_write_text()
  * @param v -> vector to print
  * @param format -> format to use
  * @see print_vect_ptr()
+ * @see vector_write_text()
  */
 void print_vect(Vector* v, char* format);
 
@@ -395,6 +897,96 @@ void print_vect(Vector* v, char* format);
  */
 void print_vect_ptr(Vector* v, char* format);
 
+/**
+ * @brief Writes every entry of v as text to f, entries are separated by delim and followed by a newline.
+ * <br> Output is formatted in a buffer and written in big blocks. Floats are written with the fewest digits that read back to the same value.
+ * <br> Example: vector_write_text(v, ValueInt32, ',', stdout) will print "1,2,3\n"
+ * <br> Raises ObjectSizeMismatchError if vobjsize(v) isn't the size of type, IOError if writing fails.
+ * @param v -> vector to write
+ * @param type -> type of the entries of v
+ * @param delim -> separator to put between entries
+ * @param f -> file to write to
+ * @return number of bytes written
+ */
+size_t vector_write_text(Vector* v, ArrayUtilsValueType type, char delim, FILE* f);
+
+/**
+ * @brief Parses numbers of type from f until EOF and appends them to v.
+ * <br> Numbers can be separated by delim or any whitespace, the vector is reserved once from the size of the file when it's known.
+ * <br> Raises ObjectSizeMismatchError if vobjsize(v) isn't the size of type, TextParseError on malformed or out of range numbers, IOError if reading fails.
+ * @param v -> vector to append to
+ * @param type -> type of the entries of v
+ * @param delim -> separator between numbers
+ * @param f -> file to read from
+ * @return number of values read
+ */
+size_t vector_read_text(Vector* v, ArrayUtilsValueType type, char delim, FILE* f);
+
+#ifdef ARRAYUTILS_POSIX
+/**
+ * @brief Same as vector_write_text() but writes directly to a file descriptor
+ * @param v -> vector to write
+ * @param type -> type of the entries of v
+ * @param delim -> separator to put between entries
+ * @param fd -> file descriptor to write to
+ * @return number of bytes written
+ * @see vector_write_text()
+ */
+size_t vector_write_text_fd(Vector* v, ArrayUtilsValueType type, char delim, int fd);
+
+/**
+ * @brief Same as vector_read_text() but reads directly from a file descriptor
+ * @param v -> vector to append to
+ * @param type -> type of the entries of v
+ * @param delim -> separator between numbers
+ * @param fd -> file descriptor to read from
+ * @return number of values read
+ * @see vector_read_text()
+ */
+size_t vector_read_text_fd(Vector* v, ArrayUtilsValueType type, char delim, int fd);
+
+/**
+ * @brief Receives each chunk of objects read by vector_read_fd_chunks(), ctx is the pointer given to it
+ * @see vector_read_fd_chunks()
+ */
+typedef void (*ArrayUtilsChunkCallback)(const void* objs, size_t nobj, void* ctx);
+
+/**
+ * @brief Reads raw objects from fd until EOF, appending them to v. Data is read directly into the capacity of v.
+ * <br> Regular files are reserved once from their size and read with several requests in flight at once,
+ * <br> through io_uring on Linux when available, otherwise with preadv/readv. Pipes and sockets are read one request at a time.
+ * <br> Raises IOError if reading fails or the data ends in the middle of an object.
+ * @param v -> vector to append to
+ * @param fd -> file descriptor to read from
+ * @return number of objects appended
+ */
+size_t vector_read_fd(Vector* v, int fd);
+
+/**
+ * @brief Reads raw objects from fd until EOF, calling cb with each chunk (about 1 MiB) as soon as it's filled.
+ * <br> With io_uring the next chunks are already being read while cb runs. Without it (non Linux, old kernels, seccomp...)
+ * <br> reading and cb take turns: regular files are only hinted to the kernel for read ahead in the meantime, pipes and sockets aren't overlapped at all.
+ * <br> v is only used as the buffer for the chunks: its contents are unspecified afterwards and its objsize sets the size of the objects.
+ * <br> The pointer given to cb is only valid until cb returns.
+ * @param v -> vector used as buffer
+ * @param fd -> file descriptor to read from
+ * @param cb -> callback receiving the chunks
+ * @param ctx -> passed as is to cb
+ * @return number of objects read
+ * @see vector_read_fd()
+ */
+size_t vector_read_fd_chunks(Vector* v, int fd, ArrayUtilsChunkCallback cb, void* ctx);
+
+/**
+ * @brief Writes the raw data of v to fd, with the same strategy as vector_read_fd(). Raises IOError if writing fails.
+ * @param v -> vector to write
+ * @param fd -> file descriptor to write to
+ * @return number of bytes written
+ * @see vector_read_fd()
+ */
+size_t vector_write_fd(Vector* v, int fd);
+#endif
+
 /**
  * @brief This functions frees each and every vector allocated by any function of this header.
  * <br> This is to facilitate memory management, since you just need to call this function at the end of whatever you want.
@@ -405,7 +997,7 @@ void free_all_arrayutils_structures();
 
 /**
  * @brief Exposes internal list of all currently allocated vectors. Use with caution, as this has no guarantees.
- * <br> If you free any vectors from this, make sure to also modify the .nvectors parameter.
+ * <br> vector_free() already removes the vector from this list, if you free any vectors in some other way make sure to also modify the .nvectors parameter.
  * @return pointer to internal struct of allocated vectors
  */
 AllocatedArrays* expose_internal_arrays();
@@ -420,7 +1012,7 @@ void set_resize_factor(unsigned int factor);
  * @brief Sets default size to use when allocating, default is 1.
  * @param size
  */
-void set_default_capacity(unsigned int size);
+void set_default_capacity(size_t size);
 
 /**
  * @brief Returns currently used resize factor
@@ -432,7 +1024,23 @@ unsigned int get_resize_factor();
  * @brief Returns currently used default capacity
  * @return default capacity
  */
-unsigned int get_default_capacity();
+size_t get_default_capacity();
+
+/**
+ * @brief Sets the size in bytes from which bulk copies (add_range_*, replace_range_*, fill) use streaming stores that bypass the cache.
+ * <br> Default is (size_t)-1, i.e. always plain memcpy/memmove: libc already switches to streaming stores for big copies on most systems
+ * <br> and measured faster than this library's own streaming. tests/bench_copy.c compares both on the running machine, lower this only if it pays off there.
+ * <br> Overlapping moves (shifting the tail on insertion) always use memmove.
+ * <br> Streaming stores are only available when compiled with SSE2 support, otherwise this has no effect.
+ * @param bytes
+ */
+void set_nontemporal_threshold(size_t bytes);
+
+/**
+ * @brief Returns currently used threshold for streaming copies
+ * @return threshold in bytes
+ */
+size_t get_nontemporal_threshold();
 
 /**
  * @brief Converts an error code to the string representation of said error code
@@ -463,4 +1071,8 @@ void override_signal_exception_arrayutils(void (*func)(int));
  */
 void set_trace_lvl_arrayutils(ArrayUtilsTraceLevel trace_lvl);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif //ARRAYUTILS_ARRAYUTILS_H
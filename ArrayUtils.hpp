@@ -0,0 +1,301 @@
+/**
+ * @brief file ArrayUtils.hpp
+ * @author Alessio Rosiello
+ * @brief Header only C++ wrapper over the Vector of ArrayUtils.h
+ * <br> Requires C++17, the C part (ArrayUtils.c) still has to be compiled and linked as usual.
+ */
+
+#ifndef ARRAYUTILS_ARRAYUTILS_HPP
+#define ARRAYUTILS_ARRAYUTILS_HPP
+
+#include "ArrayUtils.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace arrayutils {
+
+/**
+ * @brief Non owning view over contiguous objects, like std::span
+ */
+template <typename T>
+class span {
+    T* ptr_;
+    size_t size_;
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using iterator = T*;
+    using reverse_iterator = std::reverse_iterator<T*>;
+
+    constexpr span() noexcept : ptr_(nullptr), size_(0) {}
+    constexpr span(T* ptr, size_t size) noexcept : ptr_(ptr), size_(size) {}
+
+    constexpr T* data() const noexcept { return ptr_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr size_t size_bytes() const noexcept { return size_ * sizeof(T); }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T* begin() const noexcept { return ptr_; }
+    constexpr T* end() const noexcept { return ptr_ + size_; }
+    constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+    constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+    constexpr T& operator[](size_t i) const noexcept { return ptr_[i]; }
+    constexpr T& front() const noexcept { return ptr_[0]; }
+    constexpr T& back() const noexcept { return ptr_[size_ - 1]; }
+
+    /**
+     * @brief View over count objects starting at offset, or up to the end if count is left out
+     */
+    constexpr span subspan(size_t offset, size_t count = ARRAYUTILS_NPOS) const noexcept {
+        return span(ptr_ + offset, count == ARRAYUTILS_NPOS ? size_ - offset : count);
+    }
+
+    constexpr operator span<const T>() const noexcept { return span<const T>(ptr_, size_); }
+};
+
+/**
+ * @brief Owning, move only handle to a Vector with objsize sizeof(T).
+ * <br> Moving steals the underlying Vector, copying has to be asked for explicitly with clone().
+ * <br> A moved-from vector is empty (size() and capacity() are 0, data() is nullptr) and stays usable, the next insertion creates a new Vector.
+ * <br> The destructor frees the Vector (removing it from the list of allocated vectors), so don't free handle() yourself.
+ * <br> free_all_arrayutils_structures() frees the Vector of every live handle too: after it the handles can only be destroyed
+ * <br> (which then does nothing) or assigned to, any other use reads freed memory.
+ * <br> Errors (out of bounds at(), allocation failures...) go through the usual handler of the library, nothing is thrown.
+ * <br> Objects are moved around with memcpy and realloc, so T has to be trivially copyable.
+ */
+template <typename T>
+class vector {
+    static_assert(std::is_trivially_copyable_v<T>, "arrayutils::vector moves its objects with memcpy/realloc, T must be trivially copyable");
+
+    Vector* v_;
+    size_t generation_;     // free_all_arrayutils_structures() calls seen when v_ was created, v_ is gone once they differ
+
+    explicit vector(Vector* v) noexcept : v_(v), generation_(current_generation()) {}
+
+    static size_t current_generation() noexcept { return expose_internal_arrays()->generation; }
+
+    // frees v_ unless free_all_arrayutils_structures() already did
+    void drop() noexcept {
+        if (v_ != nullptr && generation_ == current_generation())
+            vector_free(v_);
+        v_ = nullptr;
+    }
+
+    // Vector to insert into, recreated if this vector was moved from
+    Vector* get() {
+        if (v_ == nullptr) {
+            v_ = vector_new(sizeof(T));
+            generation_ = current_generation();
+        }
+        return v_;
+    }
+
+    // true if objs points into the buffer of this vector, which growing it reallocates
+    bool aliases(span<const T> objs) const noexcept {
+        std::less<const T*> less;
+        return !objs.empty() && v_ != nullptr && !less(objs.data(), data()) && less(objs.data(), data() + capacity());
+    }
+
+    // memcmp based matching of the library only agrees with == when equal values have equal bytes
+    static constexpr bool bytewise_equality = std::has_unique_object_representations_v<T>;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    vector() : vector(vector_new(sizeof(T))) {}
+    vector(std::initializer_list<T> init) : vector(vector_fromsize(sizeof(T), init.size())) {
+        append(init.begin(), init.end());
+    }
+    template <typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    vector(It first, It last) : vector() {
+        append(first, last);
+    }
+
+    vector(const vector&) = delete;
+    vector& operator=(const vector&) = delete;
+
+    vector(vector&& other) noexcept : v_(std::exchange(other.v_, nullptr)), generation_(other.generation_) {}
+    vector& operator=(vector&& other) noexcept {
+        if (this != &other) {
+            drop();
+            v_ = std::exchange(other.v_, nullptr);
+            generation_ = other.generation_;
+        }
+        return *this;
+    }
+
+    ~vector() { drop(); }
+
+    /**
+     * @brief Empty vector with room for capacity objects. Unlike std::vector there is no size constructor, use resize() to add objects.
+     */
+    static vector with_capacity(size_t capacity) { return vector(vector_fromsize(sizeof(T), capacity)); }
+
+    /**
+     * @brief Takes ownership of a Vector created through the C API, its objsize must be sizeof(T)
+     */
+    static vector adopt(Vector* v) noexcept { return vector(v); }
+
+    /**
+     * @brief Deep copy, the only way to copy a vector
+     */
+    vector clone() const {
+        vector copy = with_capacity(size());
+        copy.append(span<const T>(data(), size()));
+        return copy;
+    }
+
+    /**
+     * @brief Underlying Vector, still owned by this object, nullptr if this vector was moved from
+     */
+    Vector* handle() const noexcept { return v_; }
+
+    /**
+     * @brief Gives up ownership of the underlying Vector, which has to be freed with vector_free() from now on
+     */
+    Vector* release() noexcept { return std::exchange(v_, nullptr); }
+
+    T* data() noexcept { return v_ != nullptr ? reinterpret_cast<T*>(vdata(v_)) : nullptr; }
+    const T* data() const noexcept { return v_ != nullptr ? reinterpret_cast<const T*>(vdata(v_)) : nullptr; }
+    size_t size() const noexcept { return v_ != nullptr ? vsize(v_) : 0; }
+    size_t capacity() const noexcept { return v_ != nullptr ? vcapacity(v_) : 0; }
+    bool empty() const noexcept { return size() == 0; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size(); }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    T& operator[](size_t i) noexcept { return data()[i]; }
+    const T& operator[](size_t i) const noexcept { return data()[i]; }
+    T& at(size_t i) { return *static_cast<T*>(vector_at(get(), i)); }
+    const T& at(size_t i) const { return const_cast<vector*>(this)->at(i); }
+    T& front() noexcept { return data()[0]; }
+    const T& front() const noexcept { return data()[0]; }
+    T& back() noexcept { return data()[size() - 1]; }
+    const T& back() const noexcept { return data()[size() - 1]; }
+
+    span<T> as_span() noexcept { return span<T>(data(), size()); }
+    span<const T> as_span() const noexcept { return span<const T>(data(), size()); }
+    operator span<T>() noexcept { return as_span(); }
+    operator span<const T>() const noexcept { return as_span(); }
+
+    void reserve(size_t capacity) { vector_reserve(get(), capacity); }
+    void resize(size_t size) { vector_resize(get(), size); }
+    void clear() noexcept {
+        if (v_ != nullptr)
+            vector_clear(v_);
+    }
+
+    void push_back(const T& value) {
+        T copy = value;     // value could live inside this vector, which add() may reallocate
+        add(get(), &copy);
+    }
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        add(get(), &value);
+        return back();
+    }
+    void pop_back() { pop_noret(get()); }
+
+    void append(span<const T> objs) {
+        if (objs.empty())
+            return;
+        if (aliases(objs)) {
+            // appending doesn't move the current objects, so objs only has to follow the buffer if reserving reallocates it
+            size_t offset = static_cast<size_t>(objs.data() - data());
+            reserve(size() + objs.size());
+            objs = span<const T>(data() + offset, objs.size());
+        }
+        add_range_copy(get(), const_cast<T*>(objs.data()), objs.size());
+    }
+    template <typename It>
+    void append(It first, It last) {
+        using category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::is_pointer_v<It> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, T>) {
+            append(span<const T>(first, static_cast<size_t>(last - first)));
+        } else {
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>)
+                reserve(size() + static_cast<size_t>(last - first));
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+    }
+
+    /**
+     * @brief Inserts objs before index at, at == size() appends
+     */
+    void insert(size_t at, span<const T> objs) {
+        if (at == size()) {
+            append(objs);
+        } else if (aliases(objs)) {
+            // the objects from at on are shifted before objs is read, so copy them out first
+            vector copy = with_capacity(objs.size());
+            copy.append(objs);
+            insert(at, copy.as_span());
+        } else {
+            add_range_copy_at(get(), const_cast<T*>(objs.data()), objs.size(), at);
+        }
+    }
+    void erase(size_t i) { delete_noret(get(), i); }
+
+    void fill(const T& value, size_t n) {
+        T copy = value;
+        ::fill(get(), &copy, n);
+    }
+    void reverse() { std::reverse(begin(), end()); }
+
+    iterator find(const T& value) noexcept {
+        if (v_ == nullptr)
+            return end();
+        if constexpr (bytewise_equality) {
+            void* match = extract_match(v_, const_cast<T*>(&value));
+            return match != nullptr ? static_cast<T*>(match) : end();
+        } else {
+            return std::find(begin(), end(), value);
+        }
+    }
+    const_iterator find(const T& value) const noexcept { return const_cast<vector*>(this)->find(value); }
+    bool contains(const T& value) const noexcept { return find(value) != end(); }
+    size_t count(const T& value) const noexcept {
+        if (v_ == nullptr)
+            return 0;
+        if constexpr (bytewise_equality)
+            return count_matches(v_, const_cast<T*>(&value));
+        else
+            return static_cast<size_t>(std::count(begin(), end(), value));
+    }
+
+    void swap(vector& other) noexcept {
+        std::swap(v_, other.v_);
+        std::swap(generation_, other.generation_);
+    }
+    friend void swap(vector& a, vector& b) noexcept { a.swap(b); }
+};
+
+} // namespace arrayutils
+
+#endif //ARRAYUTILS_ARRAYUTILS_HPP
@@ -0,0 +1,59 @@
+//
+// Compares the bulk copy paths (add_range_copy, insertion at the front, fill) with streaming stores from 4 MiB on
+// against plain memcpy/memmove, to find out whether set_nontemporal_threshold() pays off on this machine.
+// Build and run from the repository root:
+// gcc -O2 -I. tests/bench_copy.c ArrayUtils.c -o bench_copy -lm && ./bench_copy [MiB]
+//
+
+#include "ArrayUtils.h"
+#include <time.h>
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// best of a few runs of each case, the destination vectors are freshly allocated every time as they would be in real use
+static void run(size_t bytes, size_t threshold, const char* name) {
+    double best[3] = {1e9, 1e9, 1e9};
+    char* src = malloc(bytes);
+    memset(src, 7, bytes);
+    set_nontemporal_threshold(threshold);
+    for (int rep = 0; rep < 5; rep++) {
+        Vector* v = vector_new(1);
+        double t = now();
+        add_range_copy(v, src, bytes);
+        t = now() - t;
+        best[0] = t < best[0] ? t : best[0];
+
+        char ins[64] = {1};
+        t = now();
+        add_range_copy_at(v, ins, sizeof(ins), 0);
+        t = now() - t;
+        best[1] = t < best[1] ? t : best[1];
+        vector_free(v);
+
+        int pattern = 0x01020304;
+        Vector* w = vector_new(sizeof(int));
+        t = now();
+        fill(w, &pattern, bytes / sizeof(int));
+        t = now() - t;
+        best[2] = t < best[2] ? t : best[2];
+        vector_free(w);
+    }
+    free(src);
+    printf("%-10s copy %7.1f MB/s   insert at 0 %7.1f MB/s   fill %7.1f MB/s\n", name,
+           (double)bytes / best[0] / 1e6, (double)bytes / best[1] / 1e6, (double)bytes / best[2] / 1e6);
+}
+
+int main(int argc, char** argv) {
+    size_t mib = argc > 1 ? (size_t)atol(argv[1]) : 256;
+    size_t bytes = mib << 20;
+    size_t threshold = get_nontemporal_threshold();
+    printf("%zu MiB, default threshold %zu bytes\n", mib, threshold);
+    run(bytes, (size_t)4 << 20, "streaming");
+    run(bytes, (size_t)-1, "libc");
+    set_nontemporal_threshold(threshold);
+    return 0;
+}
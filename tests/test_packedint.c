@@ -0,0 +1,140 @@
+//
+// Round trip and bad input tests of PackedIntVector.
+// Build and run from the repository root:
+// gcc -O1 -g -fsanitize=address,undefined -I. tests/test_packedint.c ArrayUtils.c -o test_packedint -lm && ./test_packedint
+//
+
+#include "ArrayUtils.h"
+#include <assert.h>
+#include <stdint.h>
+
+static volatile sig_atomic_t raised = 0;
+
+static void on_error(int sig) {
+    (void)sig;
+    raised++;
+}
+
+static uint64_t state = 88172645463325252ULL;
+
+static uint64_t next_random() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// sorted ids, constants, random values, small jittery steps, mixed widths and extremes
+static int64_t make_value(int kind, size_t i, int64_t prev) {
+    switch (kind) {
+        case 0: return prev + (int64_t)(next_random() % 5);
+        case 1: return 7;
+        case 2: return (int64_t)next_random();
+        case 3: return prev + (int64_t)(next_random() % 1000) - 500;
+        case 4: return (int64_t)(next_random() % (1ULL << (i % 64)));
+        default: return i % 3 == 0 ? INT64_MIN : INT64_MAX;
+    }
+}
+
+static void check_same(PackedIntVector* p, const int64_t* values, size_t n) {
+    assert(packedint_size(p) == n);
+    for (size_t i = 0; i < n; i += 7)
+        assert(packedint_get(p, i) == values[i]);
+    Vector* out = vector_new(sizeof(int64_t));
+    packedint_decode(p, out);
+    assert(vsize(out) == n);
+    assert(n == 0 || memcmp(vdata(out), values, n * sizeof(int64_t)) == 0);
+    vector_free(out);
+}
+
+static void test_round_trip() {
+    for (int kind = 0; kind < 6; kind++) {
+        size_t n = 1000 + (size_t)kind * 37;
+        int64_t* values = malloc(n * sizeof(int64_t));
+        int64_t prev = 0;
+        for (size_t i = 0; i < n; i++)
+            prev = values[i] = make_value(kind, i, prev);
+
+        PackedIntVector p = packedint_new();
+        packedint_add_range(&p, values, n / 2);
+        for (size_t i = n / 2; i < n; i++)
+            packedint_add(&p, values[i]);
+        check_same(&p, values, n);
+
+        for (int t = 0; t < 20; t++) {
+            int64_t v = values[next_random() % n];
+            size_t count = 0, first = ARRAYUTILS_NPOS, found;
+            for (size_t i = 0; i < n; i++) {
+                if (values[i] == v) {
+                    count++;
+                    if (first == ARRAYUTILS_NPOS)
+                        first = i;
+                }
+            }
+            assert(packedint_count(&p, v) == count);
+            assert(packedint_any_match(&p, v, &found) && found == first);
+        }
+
+        Vector* bytes = vector_new(1);
+        packedint_serialize(&p, bytes);
+        PackedIntVector q = packedint_deserialize(vdata(bytes), vsize(bytes));
+        check_same(&q, values, n);
+
+        packedint_free(&p);
+        packedint_free(&q);
+        vector_free(bytes);
+        free(values);
+    }
+}
+
+static void test_bad_input() {
+    PackedIntVector p = packedint_new();
+    for (int64_t i = 0; i < 1000; i++)
+        packedint_add(&p, i * i);
+    Vector* bytes = vector_new(1);
+    packedint_serialize(&p, bytes);
+    unsigned char* data = vdata(bytes);
+    size_t len = vsize(bytes);
+
+    // every truncation must be refused and leave nothing readable behind
+    for (size_t cut = 0; cut < len; cut++) {
+        raised = 0;
+        PackedIntVector q = packedint_deserialize(data, cut);
+        assert(raised == 1);
+        assert(packedint_size(&q) == 0);
+        check_same(&q, NULL, 0);
+        packedint_free(&q);
+    }
+
+    // wrong magic
+    unsigned char* copy = malloc(len);
+    memcpy(copy, data, len);
+    copy[0] ^= 0xff;
+    raised = 0;
+    PackedIntVector q = packedint_deserialize(copy, len);
+    assert(raised == 1 && packedint_size(&q) == 0);
+    packedint_free(&q);
+
+    // a block whose words lie past the end of the packed words
+    memcpy(copy, data, len);
+    size_t header = sizeof(uint32_t) + 3 * sizeof(uint64_t);
+    for (size_t b = 0; b < 8; b++)
+        copy[header + b + 32] = 0xff;     // offset field of the first block
+    raised = 0;
+    q = packedint_deserialize(copy, len);
+    assert(raised == 1 && packedint_size(&q) == 0);
+    check_same(&q, NULL, 0);
+    packedint_free(&q);
+
+    free(copy);
+    vector_free(bytes);
+    packedint_free(&p);
+}
+
+int main() {
+    test_round_trip();
+    override_signal_exception_arrayutils(on_error);
+    test_bad_input();
+    printf("test_packedint: ok\n");
+    return 0;
+}
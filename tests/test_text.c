@@ -0,0 +1,211 @@
+//
+// Round trip and bad input tests of the text import/export functions.
+// Build and run from the repository root:
+// gcc -O1 -g -fsanitize=address,undefined -I. tests/test_text.c ArrayUtils.c -o test_text -lm && ./test_text
+//
+
+// unistd.h declares an access() that clashes with the one of this library, its declaration is renamed out of the way
+#define access access_unistd
+#include <unistd.h>
+#undef access
+#include "ArrayUtils.h"
+#include <assert.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+
+static volatile sig_atomic_t raised = 0;
+
+static void on_error(int sig) {
+    (void)sig;
+    raised++;
+}
+
+static uint64_t state = 88172645463325252ULL;
+
+static uint64_t next_random() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// writes v to a temporary file and reads it back, through FILE* or through file descriptors
+static Vector* round_trip(Vector* v, ArrayUtilsValueType type, char delim, int use_fd) {
+    Vector* back = vector_new(vobjsize(v));
+    if (!use_fd) {
+        FILE* f = tmpfile();
+        assert(f != NULL);
+        vector_write_text(v, type, delim, f);
+        rewind(f);
+        vector_read_text(back, type, delim, f);
+        fclose(f);
+        return back;
+    }
+    char path[] = "/tmp/arrayutils_textXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    vector_write_text_fd(v, type, delim, fd);
+    int in = open(path, O_RDONLY);
+    assert(in >= 0);
+    vector_read_text_fd(back, type, delim, in);
+    close(in);
+    close(fd);
+    unlink(path);
+    return back;
+}
+
+static void expect_same(Vector* v, Vector* back) {
+    assert(vsize(back) == vsize(v));
+    assert(vsize(v) == 0 || memcmp(vdata(back), vdata(v), vsize(v) * vobjsize(v)) == 0);
+}
+
+static void test_integers() {
+    int64_t i64[] = {0, 1, -1, 42, INT64_MIN, INT64_MAX, -1000000007};
+    uint64_t u64[] = {0, 1, 99, 100, UINT64_MAX, 10000000000000000000ULL};
+    int8_t i8[] = {0, -128, 127, 5};
+    uint16_t u16[] = {0, 65535, 1000};
+    for (int use_fd = 0; use_fd < 2; use_fd++) {
+        Vector* v = vector_new(8);
+        add_range_copy(v, i64, sizeof(i64) / sizeof(*i64));
+        for (int i = 0; i < 100000; i++) {
+            int64_t x = (int64_t)next_random() >> (next_random() % 64);
+            add(v, &x);
+        }
+        Vector* back = round_trip(v, ValueInt64, ',', use_fd);
+        expect_same(v, back);
+        vector_free(back);
+        vector_clear(v);
+        add_range_copy(v, u64, sizeof(u64) / sizeof(*u64));
+        back = round_trip(v, ValueUInt64, ' ', use_fd);
+        expect_same(v, back);
+        vector_free(back);
+        vector_free(v);
+
+        v = vector_new(1);
+        add_range_copy(v, i8, sizeof(i8));
+        back = round_trip(v, ValueInt8, ';', use_fd);
+        expect_same(v, back);
+        vector_free(back);
+        vector_free(v);
+
+        v = vector_new(2);
+        add_range_copy(v, u16, sizeof(u16) / sizeof(*u16));
+        back = round_trip(v, ValueUInt16, ',', use_fd);
+        expect_same(v, back);
+        vector_free(back);
+        vector_free(v);
+    }
+}
+
+static void test_reals() {
+    double specials[] = {0.0, -0.0, 0.1, 1e300, -1e300, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 1e15, 123.456, INFINITY, -INFINITY};
+    for (int use_fd = 0; use_fd < 2; use_fd++) {
+        Vector* d = vector_new(sizeof(double));
+        Vector* f = vector_new(sizeof(float));
+        add_range_copy(d, specials, sizeof(specials) / sizeof(*specials));
+        for (int i = 0; i < 100000; i++) {
+            uint64_t bits = next_random();
+            uint32_t fbits = (uint32_t)bits;
+            double x;
+            float y;
+            memcpy(&x, &bits, 8);
+            memcpy(&y, &fbits, 4);
+            if (!isnan(x))
+                add(d, &x);
+            if (!isnan(y))
+                add(f, &y);
+        }
+        Vector* back = round_trip(d, ValueDouble, ',', use_fd);
+        expect_same(d, back);
+        vector_free(back);
+        back = round_trip(f, ValueFloat, ' ', use_fd);
+        expect_same(f, back);
+        vector_free(back);
+        vector_free(d);
+        vector_free(f);
+    }
+}
+
+// the output is the shortest text that reads back as the same value
+static void test_shortest() {
+    const char* want = "0.1,5e-324,1e+300,9.437277e+12,-0,123456\n";
+    double d[] = {0.1, 5e-324, 1e300};
+    float f[] = {9437277323264.0f, -0.0f, 123456.0f};
+    FILE* out = tmpfile();
+    Vector* v = vector_new(sizeof(double));
+    add_range_copy(v, d, 3);
+    vector_write_text(v, ValueDouble, ',', out);
+    vector_free(v);
+    v = vector_new(sizeof(float));
+    add_range_copy(v, f, 3);
+    vector_write_text(v, ValueFloat, ',', out);
+    vector_free(v);
+    char text[128] = {0};
+    rewind(out);
+    size_t n = fread(text, 1, sizeof(text) - 1, out);
+    fclose(out);
+    // the two writes end with a newline each, join them the way the expected string does
+    char* nl = strchr(text, '\n');
+    assert(nl != NULL && n > 0);
+    *nl = ',';
+    assert(strcmp(text, want) == 0);
+}
+
+// bad tokens raise TextParseError and are skipped, the good ones around them are still read
+static void expect_rejected(const char* text, ArrayUtilsValueType type, size_t objsize, size_t good) {
+    FILE* f = tmpfile();
+    fputs(text, f);
+    rewind(f);
+    Vector* v = vector_new(objsize);
+    raised = 0;
+    size_t n = vector_read_text(v, type, ',', f);
+    assert(raised == 1);
+    assert(n == good && vsize(v) == good);
+    vector_free(v);
+    fclose(f);
+}
+
+static void test_bad_input() {
+    expect_rejected("1,abc,2", ValueInt32, 4, 2);
+    expect_rejected("1,12x,2", ValueDouble, 8, 2);
+    expect_rejected("127,128", ValueInt8, 1, 1);
+    expect_rejected("-1,1", ValueUInt32, 4, 1);
+    expect_rejected("18446744073709551616,0", ValueUInt64, 8, 1);
+    expect_rejected("1e999,1", ValueDouble, 8, 1);
+    expect_rejected("1e-400,1", ValueDouble, 8, 1);
+    expect_rejected("1e39,1", ValueFloat, 4, 1);
+    expect_rejected("1e-50,1", ValueFloat, 4, 1);
+    expect_rejected("1,-", ValueInt64, 8, 1);
+
+    // subnormals set ERANGE in strtod but are in range
+    FILE* f = tmpfile();
+    fputs("4.9e-324 1e-310 1e-40", f);
+    rewind(f);
+    Vector* d = vector_new(sizeof(double));
+    raised = 0;
+    assert(vector_read_text(d, ValueDouble, ',', f) == 3 && raised == 0);
+    vector_free(d);
+    rewind(f);
+    Vector* s = vector_new(sizeof(float));
+    assert(vector_read_text(s, ValueFloat, ',', f) == 1 && raised == 2);
+    vector_free(s);
+    fclose(f);
+
+    // wrong objsize for the type
+    Vector* v = vector_new(4);
+    raised = 0;
+    vector_write_text(v, ValueInt64, ',', stdout);
+    assert(raised == 1);
+    vector_free(v);
+}
+
+int main() {
+    test_integers();
+    test_reals();
+    test_shortest();
+    override_signal_exception_arrayutils(on_error);
+    test_bad_input();
+    printf("test_text: ok\n");
+    return 0;
+}